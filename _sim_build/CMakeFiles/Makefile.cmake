@@ -0,0 +1,115 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/app/CMakeLists.txt"
+  "/root/repo/app/synap_cli/CMakeLists.txt"
+  "/root/repo/app/synap_cli_capi/CMakeLists.txt"
+  "/root/repo/app/synap_cli_ic/CMakeLists.txt"
+  "/root/repo/app/synap_cli_ic2/CMakeLists.txt"
+  "/root/repo/app/synap_cli_ip/CMakeLists.txt"
+  "/root/repo/app/synap_cli_od/CMakeLists.txt"
+  "/root/repo/app/synap_cli_od2/CMakeLists.txt"
+  "/root/repo/app/synap_init/CMakeLists.txt"
+  "/root/repo/lib/CMakeLists.txt"
+  "/root/repo/lib/miniz/CMakeLists.txt"
+  "/root/repo/lib/nlohmann/CMakeLists.txt"
+  "/root/repo/lib/stb/CMakeLists.txt"
+  "/root/repo/lib/synap_app/CMakeLists.txt"
+  "/root/repo/lib/synap_base/CMakeLists.txt"
+  "/root/repo/lib/synap_capi/CMakeLists.txt"
+  "/root/repo/lib/synap_device/CMakeLists.txt"
+  "/root/repo/lib/synap_img/CMakeLists.txt"
+  "/root/repo/lib/synap_postprocess/CMakeLists.txt"
+  "/root/repo/lib/synap_preprocess/CMakeLists.txt"
+  "/root/repo/lib/synap_utils/CMakeLists.txt"
+  "/root/repo/lib/synapnb/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/stb/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/miniz/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/nlohmann/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synap_utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synap_base/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synap_app/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synap_device/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synapnb/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synap_img/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synap_preprocess/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synap_postprocess/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/synap_capi/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/synap_cli/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/synap_cli_ic/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/synap_cli_capi/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/synap_cli_ic2/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/synap_cli_od/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/synap_cli_od2/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/synap_cli_ip/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "app/synap_init/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "lib/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  "lib/synap_utils/CMakeFiles/synap_utils.dir/DependInfo.cmake"
+  "lib/synap_base/CMakeFiles/synap_base.dir/DependInfo.cmake"
+  "lib/synap_app/CMakeFiles/synap_app.dir/DependInfo.cmake"
+  "lib/synap_device/CMakeFiles/synap_device.dir/DependInfo.cmake"
+  "lib/synapnb/CMakeFiles/synapnb.dir/DependInfo.cmake"
+  "lib/synap_img/CMakeFiles/synap_img.dir/DependInfo.cmake"
+  "lib/synap_preprocess/CMakeFiles/synap_preprocess.dir/DependInfo.cmake"
+  "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/DependInfo.cmake"
+  "lib/synap_capi/CMakeFiles/synap_capi.dir/DependInfo.cmake"
+  "app/synap_cli/CMakeFiles/synap_cli.dir/DependInfo.cmake"
+  "app/synap_cli_ic/CMakeFiles/synap_cli_ic.dir/DependInfo.cmake"
+  "app/synap_cli_capi/CMakeFiles/synap_cli_capi.dir/DependInfo.cmake"
+  "app/synap_cli_ic2/CMakeFiles/synap_cli_ic2.dir/DependInfo.cmake"
+  "app/synap_cli_od/CMakeFiles/synap_cli_od.dir/DependInfo.cmake"
+  "app/synap_cli_od2/CMakeFiles/synap_cli_od2.dir/DependInfo.cmake"
+  "app/synap_cli_ip/CMakeFiles/synap_cli_ip.dir/DependInfo.cmake"
+  "app/synap_init/CMakeFiles/synap_init.dir/DependInfo.cmake"
+  )
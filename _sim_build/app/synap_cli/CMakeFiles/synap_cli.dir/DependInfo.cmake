@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/app/synap_cli/main.cpp" "app/synap_cli/CMakeFiles/synap_cli.dir/main.cpp.o" "gcc" "app/synap_cli/CMakeFiles/synap_cli.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_sim_build/lib/synap_app/CMakeFiles/synap_app.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_preprocess/CMakeFiles/synap_preprocess.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synapnb/CMakeFiles/synapnb.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_device/CMakeFiles/synap_device.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_img/CMakeFiles/synap_img.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_base/CMakeFiles/synap_base.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_utils/CMakeFiles/synap_utils.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_cli.dir/main.cpp.o"
+  "CMakeFiles/synap_cli.dir/main.cpp.o.d"
+  "synap_cli"
+  "synap_cli.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_cli.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/app/synap_cli_capi/main.c" "app/synap_cli_capi/CMakeFiles/synap_cli_capi.dir/main.c.o" "gcc" "app/synap_cli_capi/CMakeFiles/synap_cli_capi.dir/main.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_sim_build/lib/synap_capi/CMakeFiles/synap_capi.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synapnb/CMakeFiles/synapnb.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_device/CMakeFiles/synap_device.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_base/CMakeFiles/synap_base.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_utils/CMakeFiles/synap_utils.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_cli_capi.dir/main.c.o"
+  "CMakeFiles/synap_cli_capi.dir/main.c.o.d"
+  "synap_cli_capi"
+  "synap_cli_capi.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/synap_cli_capi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
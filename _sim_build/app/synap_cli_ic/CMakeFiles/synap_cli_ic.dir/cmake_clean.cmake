@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_cli_ic.dir/main.cpp.o"
+  "CMakeFiles/synap_cli_ic.dir/main.cpp.o.d"
+  "synap_cli_ic"
+  "synap_cli_ic.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_cli_ic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
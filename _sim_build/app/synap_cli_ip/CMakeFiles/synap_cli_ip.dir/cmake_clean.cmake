@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_cli_ip.dir/main.cpp.o"
+  "CMakeFiles/synap_cli_ip.dir/main.cpp.o.d"
+  "synap_cli_ip"
+  "synap_cli_ip.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_cli_ip.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
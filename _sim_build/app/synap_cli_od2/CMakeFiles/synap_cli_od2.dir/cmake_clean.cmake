@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_cli_od2.dir/main.cpp.o"
+  "CMakeFiles/synap_cli_od2.dir/main.cpp.o.d"
+  "synap_cli_od2"
+  "synap_cli_od2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_cli_od2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
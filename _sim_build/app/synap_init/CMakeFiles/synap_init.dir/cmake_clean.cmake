@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_init.dir/main.cpp.o"
+  "CMakeFiles/synap_init.dir/main.cpp.o.d"
+  "synap_init"
+  "synap_init.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_init.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
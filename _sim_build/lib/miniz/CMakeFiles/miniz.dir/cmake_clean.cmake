@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/miniz.dir/miniz.c.o"
+  "CMakeFiles/miniz.dir/miniz.c.o.d"
+  "libminiz.a"
+  "libminiz.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/miniz.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_app.dir/src/arg_parser.cpp.o"
+  "CMakeFiles/synap_app.dir/src/arg_parser.cpp.o.d"
+  "CMakeFiles/synap_app.dir/src/label_info.cpp.o"
+  "CMakeFiles/synap_app.dir/src/label_info.cpp.o.d"
+  "libsynap_app.a"
+  "libsynap_app.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_app.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/synap_base/src/metadata.cpp" "lib/synap_base/CMakeFiles/synap_base.dir/src/metadata.cpp.o" "gcc" "lib/synap_base/CMakeFiles/synap_base.dir/src/metadata.cpp.o.d"
+  "/root/repo/lib/synap_base/src/types.cpp" "lib/synap_base/CMakeFiles/synap_base.dir/src/types.cpp.o" "gcc" "lib/synap_base/CMakeFiles/synap_base.dir/src/types.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_sim_build/lib/synap_utils/CMakeFiles/synap_utils.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_base.dir/src/metadata.cpp.o"
+  "CMakeFiles/synap_base.dir/src/metadata.cpp.o.d"
+  "CMakeFiles/synap_base.dir/src/types.cpp.o"
+  "CMakeFiles/synap_base.dir/src/types.cpp.o.d"
+  "libsynap_base.a"
+  "libsynap_base.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_base.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_capi.dir/synap_cnetwork.cpp.o"
+  "CMakeFiles/synap_capi.dir/synap_cnetwork.cpp.o.d"
+  "libsynap_capi.a"
+  "libsynap_capi.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_capi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_device.dir/synap_device_simulator.cpp.o"
+  "CMakeFiles/synap_device.dir/synap_device_simulator.cpp.o.d"
+  "libsynap_device.a"
+  "libsynap_device.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_device.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
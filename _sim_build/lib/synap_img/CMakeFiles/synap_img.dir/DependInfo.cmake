@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/synap_img/src/image_convert.cpp" "lib/synap_img/CMakeFiles/synap_img.dir/src/image_convert.cpp.o" "gcc" "lib/synap_img/CMakeFiles/synap_img.dir/src/image_convert.cpp.o.d"
+  "/root/repo/lib/synap_img/src/image_resize.cpp" "lib/synap_img/CMakeFiles/synap_img.dir/src/image_resize.cpp.o" "gcc" "lib/synap_img/CMakeFiles/synap_img.dir/src/image_resize.cpp.o.d"
+  "/root/repo/lib/synap_img/src/image_utils.cpp" "lib/synap_img/CMakeFiles/synap_img.dir/src/image_utils.cpp.o" "gcc" "lib/synap_img/CMakeFiles/synap_img.dir/src/image_utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_sim_build/lib/synap_utils/CMakeFiles/synap_utils.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_base/CMakeFiles/synap_base.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_img.dir/src/image_convert.cpp.o"
+  "CMakeFiles/synap_img.dir/src/image_convert.cpp.o.d"
+  "CMakeFiles/synap_img.dir/src/image_resize.cpp.o"
+  "CMakeFiles/synap_img.dir/src/image_resize.cpp.o.d"
+  "CMakeFiles/synap_img.dir/src/image_utils.cpp.o"
+  "CMakeFiles/synap_img.dir/src/image_utils.cpp.o.d"
+  "libsynap_img.a"
+  "libsynap_img.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_img.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/synap_postprocess/src/classifier.cpp" "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/src/classifier.cpp.o" "gcc" "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/src/classifier.cpp.o.d"
+  "/root/repo/lib/synap_postprocess/src/detector.cpp" "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/src/detector.cpp.o" "gcc" "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/src/detector.cpp.o.d"
+  "/root/repo/lib/synap_postprocess/src/image_postprocessor.cpp" "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/src/image_postprocessor.cpp.o" "gcc" "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/src/image_postprocessor.cpp.o.d"
+  "/root/repo/lib/synap_postprocess/src/json_utils.cpp" "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/src/json_utils.cpp.o" "gcc" "lib/synap_postprocess/CMakeFiles/synap_postprocess.dir/src/json_utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_sim_build/lib/synapnb/CMakeFiles/synapnb.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_img/CMakeFiles/synap_img.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_device/CMakeFiles/synap_device.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_base/CMakeFiles/synap_base.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_utils/CMakeFiles/synap_utils.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
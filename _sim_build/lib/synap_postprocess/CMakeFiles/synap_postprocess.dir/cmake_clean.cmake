@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_postprocess.dir/src/classifier.cpp.o"
+  "CMakeFiles/synap_postprocess.dir/src/classifier.cpp.o.d"
+  "CMakeFiles/synap_postprocess.dir/src/detector.cpp.o"
+  "CMakeFiles/synap_postprocess.dir/src/detector.cpp.o.d"
+  "CMakeFiles/synap_postprocess.dir/src/image_postprocessor.cpp.o"
+  "CMakeFiles/synap_postprocess.dir/src/image_postprocessor.cpp.o.d"
+  "CMakeFiles/synap_postprocess.dir/src/json_utils.cpp.o"
+  "CMakeFiles/synap_postprocess.dir/src/json_utils.cpp.o.d"
+  "libsynap_postprocess.a"
+  "libsynap_postprocess.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_postprocess.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_preprocess.dir/src/input_data.cpp.o"
+  "CMakeFiles/synap_preprocess.dir/src/input_data.cpp.o.d"
+  "CMakeFiles/synap_preprocess.dir/src/preprocessor.cpp.o"
+  "CMakeFiles/synap_preprocess.dir/src/preprocessor.cpp.o.d"
+  "libsynap_preprocess.a"
+  "libsynap_preprocess.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_preprocess.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/synap_utils/src/bundle_parser.cpp" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/bundle_parser.cpp.o" "gcc" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/bundle_parser.cpp.o.d"
+  "/root/repo/lib/synap_utils/src/bundle_parser_zip.cpp" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/bundle_parser_zip.cpp.o" "gcc" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/bundle_parser_zip.cpp.o.d"
+  "/root/repo/lib/synap_utils/src/file_utils.cpp" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/file_utils.cpp.o" "gcc" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/file_utils.cpp.o.d"
+  "/root/repo/lib/synap_utils/src/model_blob.cpp" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/model_blob.cpp.o" "gcc" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/model_blob.cpp.o.d"
+  "/root/repo/lib/synap_utils/src/string_utils.cpp" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/string_utils.cpp.o" "gcc" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/string_utils.cpp.o.d"
+  "/root/repo/lib/synap_utils/src/thread_pool.cpp" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/thread_pool.cpp.o" "gcc" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/thread_pool.cpp.o.d"
+  "/root/repo/lib/synap_utils/src/zip_tool.cpp" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/zip_tool.cpp.o" "gcc" "lib/synap_utils/CMakeFiles/synap_utils.dir/src/zip_tool.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_sim_build/lib/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
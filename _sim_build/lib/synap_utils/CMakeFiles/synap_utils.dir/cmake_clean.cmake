@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synap_utils.dir/src/bundle_parser.cpp.o"
+  "CMakeFiles/synap_utils.dir/src/bundle_parser.cpp.o.d"
+  "CMakeFiles/synap_utils.dir/src/bundle_parser_zip.cpp.o"
+  "CMakeFiles/synap_utils.dir/src/bundle_parser_zip.cpp.o.d"
+  "CMakeFiles/synap_utils.dir/src/file_utils.cpp.o"
+  "CMakeFiles/synap_utils.dir/src/file_utils.cpp.o.d"
+  "CMakeFiles/synap_utils.dir/src/model_blob.cpp.o"
+  "CMakeFiles/synap_utils.dir/src/model_blob.cpp.o.d"
+  "CMakeFiles/synap_utils.dir/src/string_utils.cpp.o"
+  "CMakeFiles/synap_utils.dir/src/string_utils.cpp.o.d"
+  "CMakeFiles/synap_utils.dir/src/thread_pool.cpp.o"
+  "CMakeFiles/synap_utils.dir/src/thread_pool.cpp.o.d"
+  "CMakeFiles/synap_utils.dir/src/zip_tool.cpp.o"
+  "CMakeFiles/synap_utils.dir/src/zip_tool.cpp.o.d"
+  "libsynap_utils.a"
+  "libsynap_utils.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synap_utils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
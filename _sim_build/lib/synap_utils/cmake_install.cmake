@@ -0,0 +1,73 @@
+# Install script for directory: /root/repo/lib/synap_utils
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE STATIC_LIBRARY FILES "/root/repo/_sim_build/lib/synap_utils/libsynap_utils.a")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  list(APPEND CMAKE_ABSOLUTE_DESTINATION_FILES
+   "/synap/bundle_parser.hpp;/synap/bundle_parser_dir.hpp;/synap/bundle_parser_zip.hpp;/synap/enum_utils.hpp;/synap/file_utils.hpp;/synap/logging.hpp;/synap/model_blob.hpp;/synap/simd.hpp;/synap/string_utils.hpp;/synap/thread_pool.hpp;/synap/timer.hpp;/synap/zip_tool.hpp")
+  if(CMAKE_WARN_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(WARNING "ABSOLUTE path INSTALL DESTINATION : ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  if(CMAKE_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(FATAL_ERROR "ABSOLUTE path INSTALL DESTINATION forbidden (by caller): ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  file(INSTALL DESTINATION "/synap" TYPE FILE FILES
+    "/root/repo/lib/synap_utils/inc/synap/bundle_parser.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/bundle_parser_dir.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/bundle_parser_zip.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/enum_utils.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/file_utils.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/logging.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/model_blob.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/simd.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/string_utils.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/thread_pool.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/timer.hpp"
+    "/root/repo/lib/synap_utils/inc/synap/zip_tool.hpp"
+    )
+endif()
+
@@ -0,0 +1,36 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/synapnb/src/allocator.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/allocator.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/allocator.cpp.o.d"
+  "/root/repo/lib/synapnb/src/allocator_synap.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/allocator_synap.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/allocator_synap.cpp.o.d"
+  "/root/repo/lib/synapnb/src/buffer.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/buffer.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/buffer.cpp.o.d"
+  "/root/repo/lib/synapnb/src/network.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/network.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/network.cpp.o.d"
+  "/root/repo/lib/synapnb/src/network_pool.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/network_pool.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/network_pool.cpp.o.d"
+  "/root/repo/lib/synapnb/src/network_statistics.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/network_statistics.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/network_statistics.cpp.o.d"
+  "/root/repo/lib/synapnb/src/npu.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/npu.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/npu.cpp.o.d"
+  "/root/repo/lib/synapnb/src/predictor_bundle.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/predictor_bundle.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/predictor_bundle.cpp.o.d"
+  "/root/repo/lib/synapnb/src/predictor_ebg.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/predictor_ebg.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/predictor_ebg.cpp.o.d"
+  "/root/repo/lib/synapnb/src/quantization.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/quantization.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/quantization.cpp.o.d"
+  "/root/repo/lib/synapnb/src/quantization_kernels.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/quantization_kernels.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/quantization_kernels.cpp.o.d"
+  "/root/repo/lib/synapnb/src/synap_driver.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/synap_driver.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/synap_driver.cpp.o.d"
+  "/root/repo/lib/synapnb/src/tensor.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/tensor.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/tensor.cpp.o.d"
+  "/root/repo/lib/synapnb/src/trace.cpp" "lib/synapnb/CMakeFiles/synapnb.dir/src/trace.cpp.o" "gcc" "lib/synapnb/CMakeFiles/synapnb.dir/src/trace.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_sim_build/lib/synap_device/CMakeFiles/synap_device.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_utils/CMakeFiles/synap_utils.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/synap_base/CMakeFiles/synap_base.dir/DependInfo.cmake"
+  "/root/repo/_sim_build/lib/miniz/CMakeFiles/miniz.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/synapnb.dir/src/allocator.cpp.o"
+  "CMakeFiles/synapnb.dir/src/allocator.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/allocator_synap.cpp.o"
+  "CMakeFiles/synapnb.dir/src/allocator_synap.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/buffer.cpp.o"
+  "CMakeFiles/synapnb.dir/src/buffer.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/network.cpp.o"
+  "CMakeFiles/synapnb.dir/src/network.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/network_pool.cpp.o"
+  "CMakeFiles/synapnb.dir/src/network_pool.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/network_statistics.cpp.o"
+  "CMakeFiles/synapnb.dir/src/network_statistics.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/npu.cpp.o"
+  "CMakeFiles/synapnb.dir/src/npu.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/predictor_bundle.cpp.o"
+  "CMakeFiles/synapnb.dir/src/predictor_bundle.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/predictor_ebg.cpp.o"
+  "CMakeFiles/synapnb.dir/src/predictor_ebg.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/quantization.cpp.o"
+  "CMakeFiles/synapnb.dir/src/quantization.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/quantization_kernels.cpp.o"
+  "CMakeFiles/synapnb.dir/src/quantization_kernels.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/synap_driver.cpp.o"
+  "CMakeFiles/synapnb.dir/src/synap_driver.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/tensor.cpp.o"
+  "CMakeFiles/synapnb.dir/src/tensor.cpp.o.d"
+  "CMakeFiles/synapnb.dir/src/trace.cpp.o"
+  "CMakeFiles/synapnb.dir/src/trace.cpp.o.d"
+  "libsynapnb.pdb"
+  "libsynapnb.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/synapnb.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
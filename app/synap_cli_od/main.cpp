@@ -15,6 +15,7 @@
 #include "synap/file_utils.hpp"
 #include <iomanip>
 #include <iostream>
+#include <map>
 
 
 using namespace std;
@@ -32,12 +33,25 @@ int main(int argc, char* argv[])
     bool nms = !args.has("--disable-nms", "Disable Non-Max-Suppression algorithm");
     float iou_threshold = stof(args.get("--iou-threshold", "<thr> IOU threashold for NMS", "0.5"));
     bool iou_with_min = args.has("--iou-with-min", "Use min area instead of union to compute IOU");
+    bool nms_per_class = args.has("--nms-per-class", "Only suppress overlapping detections of the same class");
+    int pre_nms_top_k = stoi(args.get("--pre-nms-top-k", "<n> Max number of detections considered for NMS [0: all]", "0"));
+    string mask_format = args.get("--mask-format", "<fmt> Segmentation mask format: float, bits, bytes, rle", "float");
     args.check_help("--help", "Show help");
     validate_model_arg(model, nb, meta);
+    const map<string, BinaryMask::Encoding> mask_encodings{
+        {"float", BinaryMask::Encoding::none}, {"bits", BinaryMask::Encoding::bits},
+        {"bytes", BinaryMask::Encoding::bytes}, {"rle", BinaryMask::Encoding::rle}};
+    auto mask_encoding = mask_encodings.find(mask_format);
+    if (mask_encoding == mask_encodings.end()) {
+        cerr << "Invalid mask format: " << mask_format << endl;
+        return 1;
+    }
 
     Preprocessor preprocessor;
     Network network;
-    Detector detector(score_threshold, n_max, nms, iou_threshold, iou_with_min);
+    Detector detector(score_threshold, n_max, nms, iou_threshold, iou_with_min, nms_per_class,
+                      pre_nms_top_k);
+    detector.set_mask_encoding(mask_encoding->second);
     LabelInfo info(file_find_up("info.json", filename_path(model)));
     cout << "Loading network: " << model << endl;
     if (!network.load_model(model, meta)) {
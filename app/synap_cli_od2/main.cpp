@@ -36,6 +36,8 @@ int main(int argc, char* argv[])
     bool nms = !args.has("--disable-nms", "Disable Non-Max-Suppression algorithm");
     float iou_threshold = stof(args.get("--iou-threshold", "<thr> IOU threashold for NMS", "0.5"));
     bool iou_with_min = args.has("--iou-with-min", "Use min area instead of union to compute IOU");
+    bool nms_per_class = args.has("--nms-per-class", "Only suppress overlapping detections of the same class");
+    int pre_nms_top_k = stoi(args.get("--pre-nms-top-k", "<n> Max number of detections considered for NMS [0: all]", "0"));
     args.check_help("--help", "Show help");
     validate_model_arg(model, nb, meta);
     validate_model_arg(model2, nb2, meta2);
@@ -43,7 +45,8 @@ int main(int argc, char* argv[])
     Preprocessor preprocessor;
     Network network2;
     Network network1;
-    Detector detector(score_threshold, n_max, nms, iou_threshold, iou_with_min);
+    Detector detector(score_threshold, n_max, nms, iou_threshold, iou_with_min, nms_per_class,
+                      pre_nms_top_k);
     LabelInfo info(file_find_up("info.json", filename_path(model2)));
     cout << "Loading network 1: " << model << endl;
     if (!network1.load_model(model, meta)) {
@@ -103,6 +103,7 @@ struct Mask {
     inline operator bool() const { return !(_data.empty()); }
     const std::vector<float>& buffer() const { return _data; }
     const float* data() const;
+    float* data();
     void set_value(uint32_t row, uint32_t col, float& val);
 private:
     std::vector<float> _data;
@@ -120,6 +121,71 @@ struct Rect {
 };
 
 
+/// Binary segment mask cropped to the bounding box of a detection.
+/// A compact alternative to Mask: only the pixels inside the box are stored, as bits, bytes
+/// or run lengths, and the mask can be upsampled to image coordinates when needed.
+struct BinaryMask {
+    /// Pixel encoding
+    enum class Encoding {
+        /// No mask
+        none,
+        /// 1 bit per pixel, row by row without padding, most significant bit first
+        bits,
+        /// 1 byte per pixel (0 or 1), row by row
+        bytes,
+        /// Lengths of the alternating runs of 0 and 1 pixels, row by row, starting with 0
+        rle
+    };
+
+    BinaryMask();
+
+    /// Create from the values of a mask.
+    /// @param values: value of the pixel at the top-left corner of rect
+    /// @param stride: distance between rows in values
+    /// @param threshold: pixels with value > threshold are set
+    /// @param size: size of the entire mask
+    /// @param rect: part of the mask stored
+    /// @param image_rect: part of the image covered by the entire mask
+    /// @param encoding: pixel encoding
+    BinaryMask(const float* values, size_t stride, float threshold, const Dim2d& size, const Rect& rect,
+               const Rect& image_rect, Encoding encoding);
+
+    inline operator bool() const { return _encoding != Encoding::none; }
+    Encoding encoding() const { return _encoding; }
+
+    /// @return size of the entire mask
+    const Dim2d& size() const { return _size; }
+
+    /// @return part of the mask stored, in mask coordinates
+    const Rect& rect() const { return _rect; }
+
+    /// @return part of the image covered by the entire mask, in image coordinates
+    const Rect& image_rect() const { return _image_rect; }
+
+    /// @return encoded pixels (bits and bytes encodings)
+    const std::vector<uint8_t>& data() const { return _data; }
+
+    /// @return run lengths (rle encoding)
+    const std::vector<uint32_t>& runs() const { return _runs; }
+
+    /// @return one byte per pixel of rect() (0 or 1), row by row
+    std::vector<uint8_t> decode() const;
+
+    /// Upsample the mask to image coordinates (nearest pixel).
+    /// @param rect: part of the image to upsample, typically the bounding box of the detection
+    /// @return one byte per pixel of rect (0 or 1), row by row
+    std::vector<uint8_t> upsample(const Rect& rect) const;
+
+private:
+    Encoding _encoding{Encoding::none};
+    Dim2d _size{};
+    Rect _rect{};
+    Rect _image_rect{};
+    std::vector<uint8_t> _data;
+    std::vector<uint32_t> _runs;
+};
+
+
 /// Tensor dimensions.
 /// The order of the dimensions is given by the Layout
 struct Shape : public std::vector<int32_t> {
@@ -9,6 +9,9 @@
 #include "synap/logging.hpp"
 #include "synap/string_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace std;
 
 namespace synaptics {
@@ -33,6 +36,15 @@ const float* Mask::data() const
     return _data.data();
 }
 
+float* Mask::data()
+{
+    if (_data.empty()) {
+        LOGE << "Mask has no data";
+        return nullptr;
+    }
+    return _data.data();
+}
+
 
 void Mask::set_value(uint32_t row, uint32_t col, float& val)
 {
@@ -40,6 +52,123 @@ void Mask::set_value(uint32_t row, uint32_t col, float& val)
 }
 
 
+BinaryMask::BinaryMask() = default;
+
+BinaryMask::BinaryMask(const float* values, size_t stride, float threshold, const Dim2d& size,
+                       const Rect& rect, const Rect& image_rect, Encoding encoding)
+: _encoding(encoding), _size(size), _rect(rect), _image_rect(image_rect)
+{
+    const size_t w = max(rect.size.x, 0);
+    const size_t h = max(rect.size.y, 0);
+    switch (encoding) {
+    case Encoding::none:
+        break;
+    case Encoding::bits:
+        _data.resize((w * h + 7) / 8);
+        for (size_t y = 0, i = 0; y < h; y++) {
+            const float* row = values + y * stride;
+            for (size_t x = 0; x < w; x++, i++) {
+                _data[i / 8] |= (row[x] > threshold) << (7 - i % 8);
+            }
+        }
+        break;
+    case Encoding::bytes:
+        _data.resize(w * h);
+        for (size_t y = 0; y < h; y++) {
+            const float* row = values + y * stride;
+            for (size_t x = 0; x < w; x++) {
+                _data[y * w + x] = row[x] > threshold;
+            }
+        }
+        break;
+    case Encoding::rle: {
+        bool value = false;
+        uint32_t run = 0;
+        for (size_t y = 0; y < h; y++) {
+            const float* row = values + y * stride;
+            for (size_t x = 0; x < w; x++) {
+                if ((row[x] > threshold) != value) {
+                    _runs.push_back(run);
+                    value = !value;
+                    run = 0;
+                }
+                run++;
+            }
+        }
+        _runs.push_back(run);
+        break;
+    }
+    }
+}
+
+
+vector<uint8_t> BinaryMask::decode() const
+{
+    const size_t count = size_t(max(_rect.size.x, 0)) * max(_rect.size.y, 0);
+    vector<uint8_t> pixels;
+    switch (_encoding) {
+    case Encoding::none:
+        break;
+    case Encoding::bits:
+        pixels.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            pixels[i] = (_data[i / 8] >> (7 - i % 8)) & 1;
+        }
+        break;
+    case Encoding::bytes:
+        pixels = _data;
+        break;
+    case Encoding::rle: {
+        pixels.reserve(count);
+        uint8_t value = 0;
+        for (uint32_t run : _runs) {
+            pixels.insert(pixels.end(), min<size_t>(run, count - pixels.size()), value);
+            value ^= 1;
+        }
+        pixels.resize(count);
+        break;
+    }
+    }
+    return pixels;
+}
+
+
+vector<uint8_t> BinaryMask::upsample(const Rect& rect) const
+{
+    const int32_t w = max(rect.size.x, 0);
+    const int32_t h = max(rect.size.y, 0);
+    vector<uint8_t> pixels(size_t(w) * h);
+    if (!*this || _rect.empty() || _image_rect.empty()) {
+        return pixels;
+    }
+    const vector<uint8_t> mask = decode();
+
+    // Image coordinate to mask coordinate (nearest pixel center)
+    const auto mask_coord = [](int32_t v, int32_t image_origin, int32_t image_size, int32_t size) {
+        return int32_t(floor((v - image_origin + 0.5f) * size / image_size));
+    };
+
+    // Column of the decoded mask for each column of rect (-1 if outside the mask)
+    vector<int32_t> columns(w);
+    for (int32_t x = 0; x < w; x++) {
+        const int32_t mx = mask_coord(rect.origin.x + x, _image_rect.origin.x, _image_rect.size.x, _size.x) - _rect.origin.x;
+        columns[x] = mx >= 0 && mx < _rect.size.x ? mx : -1;
+    }
+    for (int32_t y = 0; y < h; y++) {
+        const int32_t my = mask_coord(rect.origin.y + y, _image_rect.origin.y, _image_rect.size.y, _size.y) - _rect.origin.y;
+        if (my < 0 || my >= _rect.size.y) {
+            continue;
+        }
+        const uint8_t* mask_row = &mask[size_t(my) * _rect.size.x];
+        uint8_t* row = &pixels[size_t(y) * w];
+        for (int32_t x = 0; x < w; x++) {
+            row[x] = columns[x] >= 0 ? mask_row[columns[x]] : 0;
+        }
+    }
+    return pixels;
+}
+
+
 size_t Shape::item_count() const
 {
     size_t c = 1;
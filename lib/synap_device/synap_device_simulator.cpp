@@ -2,6 +2,10 @@
 /* Copyright (C) 2022 Synaptics Incorporated */
 
 // Dummy implementation for host compilation.
+//
+// Inference does not compute anything. A simulated inference time can be specified
+// in microseconds with the SYNAP_SIMULATOR_INFERENCE_US environment variable, this allows
+// to measure the effect of overlapping CPU and NPU processing on a host machine.
 
 #include "synap_device.h"
 
@@ -10,11 +14,14 @@
 // for memfd_create
 #include <sys/mman.h>
 
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -44,6 +51,7 @@ public:
             Memid *mem_id,
             Fd *fd)
     {
+        lock_guard<mutex> lock(m_);
         const string fd_name = to_string(last_bid_ + 1);
         const int newfd = memfd_create(fd_name.c_str(), MFD_ALLOW_SEALING);
         if (newfd == -1) {
@@ -71,6 +79,7 @@ public:
 
     BufferSimulator * get_buffer(Bid bid)
     {
+        lock_guard<mutex> lock(m_);
         auto res = buffers_.find(bid);
         if (res == buffers_.end()) {
             cerr << "Buffer ID not found" << bid << endl;
@@ -88,6 +97,7 @@ public:
         bool secure)
     {
         cout << "create_io_buffer fd: " << fd << endl;
+        lock_guard<mutex> lock(m_);
         last_bid_++;
         BufferSimulator & buf = buffers_[last_bid_];
         *bid = last_bid_;
@@ -112,6 +122,7 @@ public:
     bool destroy_io_buffer(
         Bid bid)
     {
+        lock_guard<mutex> lock(m_);
         auto res = buffers_.find(bid);
         if (res == buffers_.end()) {
             cerr << "Buffer ID not found" << bid << endl;
@@ -123,6 +134,7 @@ public:
     }
 
 private:
+    mutex m_;
     int dma_heap_h_{-1};
     Bid last_bid_{0};
     map<Bid, BufferSimulator> buffers_;
@@ -150,7 +162,13 @@ public:
         Bid bid;
     };
 
-    NetworkSimulator() {}
+    NetworkSimulator()
+    {
+        const char* inference_us = getenv("SYNAP_SIMULATOR_INFERENCE_US");
+        if (inference_us) {
+            inference_time_ = chrono::microseconds(atoi(inference_us));
+        }
+    }
 
     BufferDescription * get_buffer_description(BufferAttachment buffer_attachment)
     {
@@ -218,11 +236,15 @@ public:
         // the hash of input and of the network and then retrieve the associated output for that
         // test case
 
-        // Nothing to do for now.
+        // Nothing to do for now, just simulate the inference time if requested.
+        if (inference_time_.count() > 0) {
+            this_thread::sleep_for(inference_time_);
+        }
         return true;
     }
 
 private:
+    chrono::microseconds inference_time_{};
     BufferAttachment last_buffer_attachment_{0};
     map<BufferAttachment, BufferDescription> buffers_;
 };
@@ -237,6 +259,9 @@ public:
 
     NetworkSimulator * get_network(uint32_t network_handle)
     {
+        // Networks can be used from multiple threads (asynchronous or parallel inference).
+        // std::map never relocates its elements so the pointer stays valid after unlocking.
+        lock_guard<mutex> lock(networks_m_);
         auto res = networks_.find(network_handle);
         if (res == networks_.end()) {
             cerr << "Network handle not found " << network_handle << endl;
@@ -310,6 +335,7 @@ public:
         size_t size,
         uint32_t *network_handle)
     {
+        lock_guard<mutex> lock(networks_m_);
         last_network_handle_++;
         networks_[last_network_handle_] = NetworkSimulator();
         //cout << "New Network handle: " << last_network_handle_ << endl;
@@ -322,6 +348,7 @@ public:
     {
         auto network = get_network(network_handle);
         if (!network) return false;
+        lock_guard<mutex> lock(networks_m_);
         networks_.erase(network_handle);
         return true;
     }
@@ -340,6 +367,7 @@ public:
 
 private:
     mutex m_;
+    mutex networks_m_;
     uint32_t last_network_handle_{0};
     map<uint32_t, NetworkSimulator> networks_;
 };
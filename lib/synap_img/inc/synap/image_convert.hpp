@@ -26,6 +26,26 @@ bool image_convert_yuv420sp_to_uv(const uint8_t* in_data, int32_t height, int32_
 bool image_convert_yuv420sp_to_planar(const uint8_t* in_data, int32_t height, int32_t width,
                                       uint8_t* out_data);
 
+/// YUV420SP (NV12/NV21) row to interleaved RGB or BGR:
+/// YYY.. + UVUV... -> RGBRGB...
+/// The conversion uses BT.601 limited range coefficients in fixed point, rows are converted
+/// with SIMD instructions when available.
+/// @param y_row: y components of the row
+/// @param uv_row: interleaved chroma components of the row (shared by 2 consecutive rows)
+/// @param width: row width in pixels
+/// @param out_row: converted row (width * 3 bytes)
+/// @param vu: chroma components are in vu order (NV21)
+/// @param bgr: generate BGR instead of RGB
+void image_convert_yuv420sp_row_to_rgb(const uint8_t* y_row, const uint8_t* uv_row, int32_t width,
+                                       uint8_t* out_row, bool vu, bool bgr);
+
+/// YUV420SP (NV12/NV21) to interleaved RGB or BGR:
+/// YYY..UVUV... -> RGBRGB...
+/// @param vu: chroma components are in vu order (NV21)
+/// @param bgr: generate BGR instead of RGB
+bool image_convert_yuv420sp_to_rgb(const uint8_t* in_data, int32_t height, int32_t width,
+                                   uint8_t* out_data, bool vu = false, bool bgr = false);
+
 /// planar to YUV420SP (NV12):
 /// YYY...UUU...VVV... -> YYY..UVUV...
 bool image_convert_to_yuv420sp(const uint8_t* y, const uint8_t* uv, bool planar, int32_t height,
@@ -0,0 +1,111 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Row-based resize of 8-bits interleaved images.
+///
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace synaptics {
+namespace synap {
+
+/// Resize of 8-bits interleaved images (nhwc), one output row at a time.
+/// This allows to process each resized row immediately, without storing the entire resized image.
+/// Pixel centers are aligned (as in OpenCV INTER_LINEAR), bilinear interpolation is done in fixed
+/// point with 11-bits weights. The horizontally interpolated input rows are cached so consecutive
+/// output rows only need to interpolate the input rows not already used by the previous output row.
+/// Images with 3 and 4 channels are interpolated with SIMD instructions when available.
+class ImageRowResizer {
+public:
+    /// Resize methods
+    enum class Method {
+        /// Bilinear interpolation
+        bilinear,
+        /// Nearest input pixel
+        nearest,
+        /// Average of the input pixels covered by each output pixel.
+        /// Only for integer downscaling ratios, bilinear interpolation is used otherwise.
+        area
+    };
+
+    /// Function providing the input row with the given index.
+    /// The returned data must remain valid until the next call.
+    using RowSource = std::function<const uint8_t*(int32_t y)>;
+
+    /// Prepare the resizer for a new image.
+    /// The interpolation tables are only recomputed if the parameters change.
+    /// @param in_w: input image width
+    /// @param in_h: input image height
+    /// @param channels: number of interleaved channels
+    /// @param out_w: output image width
+    /// @param out_h: output image height
+    /// @param method: resize method
+    /// @return true if success
+    bool init(int32_t in_w, int32_t in_h, int32_t channels, int32_t out_w, int32_t out_h,
+              Method method = Method::bilinear);
+
+    /// @return resize method actually used for the current image
+    Method method() const { return _method; }
+
+    /// Compute a row of the resized image.
+    /// @param in_data: input image data
+    /// @param in_stride: distance in bytes between two consecutive input rows
+    /// @param y: index of the output row to compute
+    /// @param out_row: output row (out_w * channels bytes)
+    void row(const uint8_t* in_data, size_t in_stride, int32_t y, uint8_t* out_row);
+
+    /// Compute a row of the resized image.
+    /// This allows to generate the input rows on the fly, only the rows actually needed are requested.
+    /// @param source: input rows provider
+    /// @param y: index of the output row to compute
+    /// @param out_row: output row (out_w * channels bytes)
+    void row(const RowSource& source, int32_t y, uint8_t* out_row);
+
+private:
+    // Interpolate input row in_y horizontally into one of the cached rows
+    // without overwriting the cached row keep_y
+    const int32_t* hrow(const RowSource& source, int32_t in_y, int32_t keep_y);
+
+    void bilinear_row(const RowSource& source, int32_t y, uint8_t* out_row);
+    void nearest_row(const RowSource& source, int32_t y, uint8_t* out_row);
+    void area_row(const RowSource& source, int32_t y, uint8_t* out_row);
+
+    int32_t _in_w{};
+    int32_t _in_h{};
+    int32_t _channels{};
+    int32_t _out_w{};
+    int32_t _out_h{};
+    Method _requested_method{};
+    Method _method{};
+
+    // Horizontal interpolation: offset of the left (nearest) input pixel and weight of the right one
+    std::vector<int32_t> _x_offset;
+    std::vector<int32_t> _x_weight;
+    int32_t _x_step{};
+
+    // Vertical interpolation: index of the top (nearest) input row and weight of the bottom one
+    std::vector<int32_t> _y_index;
+    std::vector<int32_t> _y_weight;
+    int32_t _y_step{};
+
+    // Horizontally interpolated input rows and the index of the row they contain
+    std::vector<int32_t> _rows[2];
+    int32_t _row_index[2]{-1, -1};
+
+    // Area: downscaling factors, reciprocal of the number of pixels averaged (32-bits fraction)
+    // and sums of the input rows covered by an output row
+    int32_t _area_x{};
+    int32_t _area_y{};
+    uint64_t _area_scale{};
+    std::vector<uint16_t> _sums;
+};
+
+
+}  // namespace synap
+}  // namespace synaptics
@@ -5,9 +5,18 @@
 
 #include "synap/image_convert.hpp"
 #include "synap/logging.hpp"
+#include "synap/simd.hpp"
 
+#include <algorithm>
 #include <cstring>
 
+#if SYNAP_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SYNAP_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 using namespace std;
 
 
@@ -103,5 +112,220 @@ bool image_convert_to_yuv420sp(const uint8_t* y, const uint8_t* uv, bool planar,
 }
 
 
+
+// YUV to RGB conversion in fixed point with 6 fractional bits (BT.601, limited range):
+// R = 1.164 (Y - 16) + 1.596 (V - 128)
+// G = 1.164 (Y - 16) - 0.391 (U - 128) - 0.813 (V - 128)
+// B = 1.164 (Y - 16) + 2.018 (U - 128)
+// All intermediate values fit in 16 bits except the blue component for the brightest colors,
+// where the SIMD kernels saturate. Saturated values are anyway clamped to 255 so the results
+// are the same as in the scalar code.
+namespace {
+
+constexpr int yuv_shift = 6;
+constexpr int yuv_round = 1 << (yuv_shift - 1);
+// 1.164 * 64 = 74.5, computed as 74 * y + y / 2
+constexpr int yuv_y = 74;
+constexpr int yuv_rv = 102;
+constexpr int yuv_gu = 25;
+constexpr int yuv_gv = 52;
+constexpr int yuv_bu = 129;
+
+
+inline uint8_t yuv_clamp(int32_t val)
+{
+    return min(max(val >> yuv_shift, 0), 255);
+}
+
+
+// Portable implementation, converts pixels from first to width
+void yuv420sp_row_to_rgb_scalar(const uint8_t* y_row, const uint8_t* uv_row, int32_t first,
+                                int32_t width, uint8_t* out_row, bool vu, bool bgr)
+{
+    uint8_t* out = out_row + first * 3;
+    const int r_ix = bgr ? 2 : 0;
+    const int b_ix = bgr ? 0 : 2;
+    for (int32_t x = first; x < width; x++) {
+        const uint8_t* uv = &uv_row[x & ~1];
+        const int32_t u = uv[vu ? 1 : 0] - 128;
+        const int32_t v = uv[vu ? 0 : 1] - 128;
+        const int32_t c = y_row[x] - 16;
+        const int32_t y = c * yuv_y + (c >> 1) + yuv_round;
+        out[r_ix] = yuv_clamp(y + yuv_rv * v);
+        out[1] = yuv_clamp(y - yuv_gu * u - yuv_gv * v);
+        out[b_ix] = yuv_clamp(y + yuv_bu * u);
+        out += 3;
+    }
+}
+
+
+#if SYNAP_SIMD_X86
+
+// Shuffle masks to interleave 16 R, G and B values to 48 bytes
+struct InterleaveMasks {
+    alignas(16) uint8_t mask[3][3][16];
+
+    InterleaveMasks()
+    {
+        for (int block = 0; block < 3; block++) {
+            for (int ch = 0; ch < 3; ch++) {
+                for (int k = 0; k < 16; k++) {
+                    int n = block * 16 + k;
+                    mask[block][ch][k] = n % 3 == ch ? n / 3 : 0x80;
+                }
+            }
+        }
+    }
+};
+
+const InterleaveMasks interleave_masks;
+
+
+// Scaled y component with rounding term, 8 items
+__attribute__((target("sse4.1")))
+inline __m128i yuv_y_sse41(__m128i y)
+{
+    y = _mm_sub_epi16(y, _mm_set1_epi16(16));
+    return _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(y, _mm_set1_epi16(yuv_y)), _mm_srai_epi16(y, 1)),
+                         _mm_set1_epi16(yuv_round));
+}
+
+
+// Convert 16 pixels at each iteration, return the number of pixels converted
+__attribute__((target("sse4.1")))
+int32_t yuv420sp_row_to_rgb_sse41(const uint8_t* y_row, const uint8_t* uv_row, int32_t width,
+                                  uint8_t* out_row, bool vu, bool bgr)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c128 = _mm_set1_epi16(128);
+    const __m128i low_byte = _mm_set1_epi16(0x00ff);
+    const __m128i* m = reinterpret_cast<const __m128i*>(interleave_masks.mask);
+    int32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i yv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y_row + x));
+        const __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv_row + x));
+        __m128i u = _mm_sub_epi16(_mm_and_si128(uv, low_byte), c128);
+        __m128i v = _mm_sub_epi16(_mm_srli_epi16(uv, 8), c128);
+        if (vu) {
+            swap(u, v);
+        }
+
+        // Chroma contributions, each one shared by 2 pixels
+        const __m128i rc = _mm_mullo_epi16(v, _mm_set1_epi16(yuv_rv));
+        const __m128i gc = _mm_add_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(yuv_gu)),
+                                         _mm_mullo_epi16(v, _mm_set1_epi16(yuv_gv)));
+        const __m128i bc = _mm_mullo_epi16(u, _mm_set1_epi16(yuv_bu));
+
+        const __m128i y_lo = yuv_y_sse41(_mm_cvtepu8_epi16(yv));
+        const __m128i y_hi = yuv_y_sse41(_mm_unpackhi_epi8(yv, zero));
+        __m128i r = _mm_packus_epi16(
+            _mm_srai_epi16(_mm_adds_epi16(y_lo, _mm_unpacklo_epi16(rc, rc)), yuv_shift),
+            _mm_srai_epi16(_mm_adds_epi16(y_hi, _mm_unpackhi_epi16(rc, rc)), yuv_shift));
+        const __m128i g = _mm_packus_epi16(
+            _mm_srai_epi16(_mm_subs_epi16(y_lo, _mm_unpacklo_epi16(gc, gc)), yuv_shift),
+            _mm_srai_epi16(_mm_subs_epi16(y_hi, _mm_unpackhi_epi16(gc, gc)), yuv_shift));
+        __m128i b = _mm_packus_epi16(
+            _mm_srai_epi16(_mm_adds_epi16(y_lo, _mm_unpacklo_epi16(bc, bc)), yuv_shift),
+            _mm_srai_epi16(_mm_adds_epi16(y_hi, _mm_unpackhi_epi16(bc, bc)), yuv_shift));
+        if (bgr) {
+            swap(r, b);
+        }
+
+        // Interleave
+        __m128i* out = reinterpret_cast<__m128i*>(out_row + x * 3);
+        for (int block = 0; block < 3; block++) {
+            const __m128i* bm = &m[block * 3];
+            _mm_storeu_si128(out + block, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(r, bm[0]),
+                                                                    _mm_shuffle_epi8(g, bm[1])),
+                                                       _mm_shuffle_epi8(b, bm[2])));
+        }
+    }
+    return x;
+}
+
+#endif  // SYNAP_SIMD_X86
+
+
+#if SYNAP_SIMD_NEON
+
+// Scaled y component with rounding term, 8 items
+inline int16x8_t yuv_y_neon(uint8x8_t y8)
+{
+    int16x8_t y = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y8)), vdupq_n_s16(16));
+    return vaddq_s16(vaddq_s16(vmulq_n_s16(y, yuv_y), vshrq_n_s16(y, 1)), vdupq_n_s16(yuv_round));
+}
+
+
+// Convert 16 pixels at each iteration, return the number of pixels converted
+int32_t yuv420sp_row_to_rgb_neon(const uint8_t* y_row, const uint8_t* uv_row, int32_t width,
+                                 uint8_t* out_row, bool vu, bool bgr)
+{
+    const int16x8_t c128 = vdupq_n_s16(128);
+    const int r_ix = bgr ? 2 : 0;
+    const int b_ix = bgr ? 0 : 2;
+    int32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16_t yv = vld1q_u8(y_row + x);
+        const uint8x8x2_t uv = vld2_u8(uv_row + x);
+        const int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uv.val[vu ? 1 : 0])), c128);
+        const int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uv.val[vu ? 0 : 1])), c128);
+
+        // Chroma contributions, each one shared by 2 pixels
+        const int16x8x2_t rc = vzipq_s16(vmulq_n_s16(v, yuv_rv), vmulq_n_s16(v, yuv_rv));
+        const int16x8_t gc1 = vmlaq_n_s16(vmulq_n_s16(u, yuv_gu), v, yuv_gv);
+        const int16x8x2_t gc = vzipq_s16(gc1, gc1);
+        const int16x8x2_t bc = vzipq_s16(vmulq_n_s16(u, yuv_bu), vmulq_n_s16(u, yuv_bu));
+
+        const int16x8_t y_lo = yuv_y_neon(vget_low_u8(yv));
+        const int16x8_t y_hi = yuv_y_neon(vget_high_u8(yv));
+        uint8x16x3_t rgb;
+        rgb.val[r_ix] = vcombine_u8(vqmovun_s16(vshrq_n_s16(vqaddq_s16(y_lo, rc.val[0]), yuv_shift)),
+                                    vqmovun_s16(vshrq_n_s16(vqaddq_s16(y_hi, rc.val[1]), yuv_shift)));
+        rgb.val[1] = vcombine_u8(vqmovun_s16(vshrq_n_s16(vqsubq_s16(y_lo, gc.val[0]), yuv_shift)),
+                                 vqmovun_s16(vshrq_n_s16(vqsubq_s16(y_hi, gc.val[1]), yuv_shift)));
+        rgb.val[b_ix] = vcombine_u8(vqmovun_s16(vshrq_n_s16(vqaddq_s16(y_lo, bc.val[0]), yuv_shift)),
+                                    vqmovun_s16(vshrq_n_s16(vqaddq_s16(y_hi, bc.val[1]), yuv_shift)));
+        vst3q_u8(out_row + x * 3, rgb);
+    }
+    return x;
+}
+
+#endif  // SYNAP_SIMD_NEON
+
+}  // namespace
+
+
+void image_convert_yuv420sp_row_to_rgb(const uint8_t* y_row, const uint8_t* uv_row, int32_t width,
+                                       uint8_t* out_row, bool vu, bool bgr)
+{
+    int32_t x = 0;
+#if SYNAP_SIMD_X86
+    if (simd_level() != SimdLevel::none) {
+        x = yuv420sp_row_to_rgb_sse41(y_row, uv_row, width, out_row, vu, bgr);
+    }
+#elif SYNAP_SIMD_NEON
+    if (simd_level() == SimdLevel::neon) {
+        x = yuv420sp_row_to_rgb_neon(y_row, uv_row, width, out_row, vu, bgr);
+    }
+#endif
+    yuv420sp_row_to_rgb_scalar(y_row, uv_row, x, width, out_row, vu, bgr);
+}
+
+
+bool image_convert_yuv420sp_to_rgb(const uint8_t* in_data, int32_t height, int32_t width,
+                                   uint8_t* out_data, bool vu, bool bgr)
+{
+    // YUV420SP (NV12) to RGB:
+    // YYY..UVUV... -> RGBRGB...
+    const uint8_t* uv_data = &in_data[height * width];
+    const int32_t uv_stride = (width + 1) & ~1;
+    for (int32_t y = 0; y < height; y++) {
+        image_convert_yuv420sp_row_to_rgb(&in_data[y * width], &uv_data[y / 2 * uv_stride], width,
+                                          &out_data[y * width * 3], vu, bgr);
+    }
+    return true;
+}
+
+
 }  // namespace synap
 }  // namespace synaptics
@@ -0,0 +1,488 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "synap/image_resize.hpp"
+#include "synap/logging.hpp"
+#include "synap/simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if SYNAP_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SYNAP_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+
+namespace synaptics {
+namespace synap {
+
+// Fixed point interpolation weights
+static constexpr int32_t weight_bits = 11;
+static constexpr int32_t weight_one = 1 << weight_bits;
+
+// Vertical interpolation of two horizontally interpolated rows
+static constexpr int32_t vshift = 2 * weight_bits;
+static constexpr int32_t vrounding = 1 << (vshift - 1);
+
+// Max number of input pixels averaged for each output pixel. This ensures that the
+// division by the number of pixels done as multiplication by its reciprocal is exact.
+static constexpr int32_t max_area = 4096;
+// Max number of input rows summed, so that the sums fit in 16 bits
+static constexpr int32_t max_area_rows = 257;
+
+
+// Compute source index and weight of the next source item for each destination item
+static void interpolation_table(int32_t in_size, int32_t out_size, int32_t multiplier,
+                                vector<int32_t>& index, vector<int32_t>& weight)
+{
+    index.resize(out_size);
+    weight.resize(out_size);
+    const double scale = double(in_size) / out_size;
+    for (int32_t i = 0; i < out_size; i++) {
+        double s = max((i + 0.5) * scale - 0.5, 0.0);
+        int32_t i0 = s;
+        int32_t w = lround((s - i0) * weight_one);
+        if (i0 >= in_size - 1) {
+            // Clamp to the last source item, make sure the next one is still inside the source
+            i0 = max(in_size - 2, 0);
+            w = in_size > 1 ? weight_one : 0;
+        }
+        index[i] = i0 * multiplier;
+        weight[i] = w;
+    }
+}
+
+
+// Compute the source index of the nearest source item for each destination item
+static void nearest_table(int32_t in_size, int32_t out_size, int32_t multiplier, vector<int32_t>& index)
+{
+    index.resize(out_size);
+    for (int32_t i = 0; i < out_size; i++) {
+        const int64_t i0 = (2 * int64_t(i) + 1) * in_size / (2 * int64_t(out_size));
+        index[i] = min<int64_t>(i0, in_size - 1) * multiplier;
+    }
+}
+
+
+namespace {
+
+// Portable implementations, process items from first to size.
+// The number of channels is a template parameter for the common cases so that the
+// inner loops are unrolled, 0 means that it is specified at runtime.
+
+template <int32_t C>
+void bilinear_hrow_scalar(const uint8_t* in, const int32_t* x_offset, const int32_t* x_weight,
+                          int32_t first, int32_t out_w, int32_t channels, int32_t step, int32_t* out)
+{
+    const int32_t c = C ? C : channels;
+    out += first * c;
+    for (int32_t x = first; x < out_w; x++) {
+        const uint8_t* p = in + x_offset[x];
+        const int32_t w1 = x_weight[x];
+        const int32_t w0 = weight_one - w1;
+        for (int32_t ch = 0; ch < c; ch++) {
+            *out++ = p[ch] * w0 + p[ch + step] * w1;
+        }
+    }
+}
+
+
+void bilinear_vrow_scalar(const int32_t* r0, const int32_t* r1, int32_t w1, int32_t first, int32_t size,
+                          uint8_t* out_row)
+{
+    const int32_t w0 = weight_one - w1;
+    for (int32_t i = first; i < size; i++) {
+        // Weights sum to one in both directions, so the result is always in the range [0, 255]
+        out_row[i] = (r0[i] * w0 + r1[i] * w1 + vrounding) >> vshift;
+    }
+}
+
+
+template <int32_t C>
+void nearest_row_scalar(const uint8_t* in, const int32_t* x_offset, int32_t out_w, int32_t channels,
+                        uint8_t* out)
+{
+    const int32_t c = C ? C : channels;
+    for (int32_t x = 0; x < out_w; x++) {
+        const uint8_t* p = in + x_offset[x];
+        for (int32_t ch = 0; ch < c; ch++) {
+            *out++ = p[ch];
+        }
+    }
+}
+
+
+void area_sum_scalar(const uint8_t* in, int32_t first, int32_t size, bool add, uint16_t* sums)
+{
+    for (int32_t i = first; i < size; i++) {
+        sums[i] = add ? sums[i] + in[i] : in[i];
+    }
+}
+
+
+template <int32_t C>
+void area_hrow_scalar(const uint16_t* sums, int32_t area_x, uint64_t scale, int32_t area,
+                      int32_t out_w, int32_t channels, uint8_t* out)
+{
+    const int32_t c = C ? C : channels;
+    const uint32_t rounding = area / 2;
+    for (int32_t x = 0; x < out_w; x++) {
+        for (int32_t ch = 0; ch < c; ch++) {
+            const uint16_t* s = sums + ch;
+            uint32_t sum = rounding;
+            for (int32_t k = 0; k < area_x; k++) {
+                sum += s[k * c];
+            }
+            *out++ = (sum * scale) >> 32;
+        }
+        sums += area_x * c;
+    }
+}
+
+
+#if SYNAP_SIMD_X86
+
+// Interpolate one pixel with 3 or 4 channels at each iteration as long as 4 bytes can be read
+// from both input pixels and 4 items written to the output. Return the number of pixels interpolated.
+// With 3 channels a 4th item is written, it is overwritten when the next pixel is interpolated,
+// so the last pixel of the row is left to the scalar code.
+__attribute__((target("sse4.1")))
+int32_t bilinear_hrow_sse41(const uint8_t* in, int32_t in_size, const int32_t* x_offset,
+                            const int32_t* x_weight, int32_t out_w, int32_t c, int32_t step, int32_t* out)
+{
+    int32_t x = 0;
+    for (; x * c + 4 <= out_w * c && x_offset[x] + step + 4 <= in_size; x++) {
+        int32_t p, q;
+        memcpy(&p, in + x_offset[x], sizeof(p));
+        memcpy(&q, in + x_offset[x] + step, sizeof(q));
+        // Interleave the items of the 2 pixels to multiply and add them with their weights
+        const __m128i pq = _mm_cvtepu8_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(p), _mm_cvtsi32_si128(q)));
+        const int32_t w1 = x_weight[x];
+        const __m128i w = _mm_set1_epi32((weight_one - w1) | (w1 << 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * c), _mm_madd_epi16(pq, w));
+    }
+    return x;
+}
+
+
+// Vertical interpolation of 4 items.
+// r0 * w0 + r1 * w1 is computed as (r0 << weight_bits) + (r1 - r0) * w1
+__attribute__((target("sse4.1")))
+inline __m128i bilinear_v4_sse41(const int32_t* r0, const int32_t* r1, __m128i w1)
+{
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1));
+    const __m128i v = _mm_add_epi32(_mm_slli_epi32(a, weight_bits), _mm_mullo_epi32(_mm_sub_epi32(b, a), w1));
+    return _mm_srai_epi32(_mm_add_epi32(v, _mm_set1_epi32(vrounding)), vshift);
+}
+
+
+// Interpolate 8 items at each iteration, return the number of items interpolated
+__attribute__((target("sse4.1")))
+int32_t bilinear_vrow_sse41(const int32_t* r0, const int32_t* r1, int32_t w1, int32_t size, uint8_t* out_row)
+{
+    const __m128i w = _mm_set1_epi32(w1);
+    int32_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m128i v16 = _mm_packs_epi32(bilinear_v4_sse41(r0 + i, r1 + i, w),
+                                            bilinear_v4_sse41(r0 + i + 4, r1 + i + 4, w));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out_row + i), _mm_packus_epi16(v16, v16));
+    }
+    return i;
+}
+
+
+// Add 16 items at each iteration, return the number of items added
+__attribute__((target("sse4.1")))
+int32_t area_sum_sse41(const uint8_t* in, int32_t size, bool add, uint16_t* sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int32_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i* s = reinterpret_cast<__m128i*>(sums + i);
+        if (add) {
+            lo = _mm_add_epi16(lo, _mm_loadu_si128(s));
+            hi = _mm_add_epi16(hi, _mm_loadu_si128(s + 1));
+        }
+        _mm_storeu_si128(s, lo);
+        _mm_storeu_si128(s + 1, hi);
+    }
+    return i;
+}
+
+#endif  // SYNAP_SIMD_X86
+
+
+#if SYNAP_SIMD_NEON
+
+// Interpolate one pixel with 3 or 4 channels at each iteration as long as 4 bytes can be read
+// from both input pixels and 4 items written to the output. Return the number of pixels interpolated.
+// With 3 channels a 4th item is written, it is overwritten when the next pixel is interpolated,
+// so the last pixel of the row is left to the scalar code.
+int32_t bilinear_hrow_neon(const uint8_t* in, int32_t in_size, const int32_t* x_offset,
+                           const int32_t* x_weight, int32_t out_w, int32_t c, int32_t step, int32_t* out)
+{
+    int32_t x = 0;
+    for (; x * c + 4 <= out_w * c && x_offset[x] + step + 4 <= in_size; x++) {
+        uint32_t p, q;
+        memcpy(&p, in + x_offset[x], sizeof(p));
+        memcpy(&q, in + x_offset[x] + step, sizeof(q));
+        const uint16x8_t pq = vmovl_u8(vcreate_u8(p | uint64_t(q) << 32));
+        const int32_t w1 = x_weight[x];
+        const uint32x4_t v = vmlal_n_u16(vmull_n_u16(vget_low_u16(pq), weight_one - w1), vget_high_u16(pq), w1);
+        vst1q_s32(out + x * c, vreinterpretq_s32_u32(v));
+    }
+    return x;
+}
+
+
+// Vertical interpolation of 4 items.
+// r0 * w0 + r1 * w1 is computed as (r0 << weight_bits) + (r1 - r0) * w1
+inline uint16x4_t bilinear_v4_neon(const int32_t* r0, const int32_t* r1, int32_t w1)
+{
+    const int32x4_t a = vld1q_s32(r0);
+    const int32x4_t b = vld1q_s32(r1);
+    return vqmovun_s32(vrshrq_n_s32(vmlaq_n_s32(vshlq_n_s32(a, weight_bits), vsubq_s32(b, a), w1), vshift));
+}
+
+
+// Interpolate 8 items at each iteration, return the number of items interpolated
+int32_t bilinear_vrow_neon(const int32_t* r0, const int32_t* r1, int32_t w1, int32_t size, uint8_t* out_row)
+{
+    int32_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const uint16x8_t v16 = vcombine_u16(bilinear_v4_neon(r0 + i, r1 + i, w1),
+                                            bilinear_v4_neon(r0 + i + 4, r1 + i + 4, w1));
+        vst1_u8(out_row + i, vqmovn_u16(v16));
+    }
+    return i;
+}
+
+
+// Add 16 items at each iteration, return the number of items added
+int32_t area_sum_neon(const uint8_t* in, int32_t size, bool add, uint16_t* sums)
+{
+    int32_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t v = vld1q_u8(in + i);
+        uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+        if (add) {
+            lo = vaddq_u16(lo, vld1q_u16(sums + i));
+            hi = vaddq_u16(hi, vld1q_u16(sums + i + 8));
+        }
+        vst1q_u16(sums + i, lo);
+        vst1q_u16(sums + i + 8, hi);
+    }
+    return i;
+}
+
+#endif  // SYNAP_SIMD_NEON
+
+}  // namespace
+
+
+bool ImageRowResizer::init(int32_t in_w, int32_t in_h, int32_t channels, int32_t out_w, int32_t out_h,
+                           Method method)
+{
+    _row_index[0] = _row_index[1] = -1;
+    if (in_w == _in_w && in_h == _in_h && channels == _channels && out_w == _out_w && out_h == _out_h &&
+        method == _requested_method) {
+        return true;
+    }
+    if (in_w <= 0 || in_h <= 0 || channels <= 0 || out_w <= 0 || out_h <= 0) {
+        LOGE << "Invalid resize from " << in_w << "x" << in_h << " to " << out_w << "x" << out_h
+             << " channels: " << channels;
+        _in_w = _in_h = _channels = _out_w = _out_h = 0;
+        return false;
+    }
+    _in_w = in_w;
+    _in_h = in_h;
+    _channels = channels;
+    _out_w = out_w;
+    _out_h = out_h;
+    _requested_method = method;
+    if (method == Method::area) {
+        _area_x = in_w / out_w;
+        _area_y = in_h / out_h;
+        const int32_t area = _area_x * _area_y;
+        if (in_w % out_w || in_h % out_h || area > max_area || _area_y > max_area_rows) {
+            LOGV << "Area resize not possible from " << in_w << "x" << in_h << " to " << out_w << "x"
+                 << out_h << ", using bilinear";
+            method = Method::bilinear;
+        }
+        else {
+            _area_scale = ((uint64_t(1) << 32) + area - 1) / area;
+            _sums.resize(in_w * channels);
+        }
+    }
+    _method = method;
+    if (method == Method::nearest) {
+        nearest_table(in_w, out_w, channels, _x_offset);
+        nearest_table(in_h, out_h, 1, _y_index);
+    }
+    else if (method == Method::bilinear) {
+        interpolation_table(in_w, out_w, channels, _x_offset, _x_weight);
+        interpolation_table(in_h, out_h, 1, _y_index, _y_weight);
+        _x_step = in_w > 1 ? channels : 0;
+        _y_step = in_h > 1 ? 1 : 0;
+        _rows[0].resize(out_w * channels);
+        _rows[1].resize(out_w * channels);
+    }
+    return true;
+}
+
+
+const int32_t* ImageRowResizer::hrow(const RowSource& source, int32_t in_y, int32_t keep_y)
+{
+    for (int i = 0; i < 2; i++) {
+        if (_row_index[i] == in_y) {
+            return _rows[i].data();
+        }
+    }
+    const int slot = _row_index[0] == keep_y ? 1 : 0;
+    _row_index[slot] = in_y;
+    int32_t* out = _rows[slot].data();
+    const uint8_t* in = source(in_y);
+    const int32_t c = _channels;
+    int32_t x = 0;
+    if (c == 3 || c == 4) {
+#if SYNAP_SIMD_X86
+        if (simd_level() != SimdLevel::none) {
+            x = bilinear_hrow_sse41(in, _in_w * c, _x_offset.data(), _x_weight.data(), _out_w, c, _x_step, out);
+        }
+#elif SYNAP_SIMD_NEON
+        if (simd_level() == SimdLevel::neon) {
+            x = bilinear_hrow_neon(in, _in_w * c, _x_offset.data(), _x_weight.data(), _out_w, c, _x_step, out);
+        }
+#endif
+    }
+    switch (c) {
+    case 1:
+        bilinear_hrow_scalar<1>(in, _x_offset.data(), _x_weight.data(), x, _out_w, c, _x_step, out);
+        break;
+    case 3:
+        bilinear_hrow_scalar<3>(in, _x_offset.data(), _x_weight.data(), x, _out_w, c, _x_step, out);
+        break;
+    case 4:
+        bilinear_hrow_scalar<4>(in, _x_offset.data(), _x_weight.data(), x, _out_w, c, _x_step, out);
+        break;
+    default:
+        bilinear_hrow_scalar<0>(in, _x_offset.data(), _x_weight.data(), x, _out_w, c, _x_step, out);
+    }
+    return out;
+}
+
+
+void ImageRowResizer::row(const uint8_t* in_data, size_t in_stride, int32_t y, uint8_t* out_row)
+{
+    row([in_data, in_stride](int32_t in_y) { return in_data + in_y * in_stride; }, y, out_row);
+}
+
+
+void ImageRowResizer::row(const RowSource& source, int32_t y, uint8_t* out_row)
+{
+    switch (_method) {
+    case Method::bilinear:
+        bilinear_row(source, y, out_row);
+        break;
+    case Method::nearest:
+        nearest_row(source, y, out_row);
+        break;
+    case Method::area:
+        area_row(source, y, out_row);
+        break;
+    }
+}
+
+
+void ImageRowResizer::bilinear_row(const RowSource& source, int32_t y, uint8_t* out_row)
+{
+    const int32_t y0 = _y_index[y];
+    const int32_t y1 = y0 + _y_step;
+    const int32_t* r0 = hrow(source, y0, y1);
+    const int32_t* r1 = hrow(source, y1, y0);
+    const int32_t w1 = _y_weight[y];
+    const int32_t size = _out_w * _channels;
+    int32_t i = 0;
+#if SYNAP_SIMD_X86
+    if (simd_level() != SimdLevel::none) {
+        i = bilinear_vrow_sse41(r0, r1, w1, size, out_row);
+    }
+#elif SYNAP_SIMD_NEON
+    if (simd_level() == SimdLevel::neon) {
+        i = bilinear_vrow_neon(r0, r1, w1, size, out_row);
+    }
+#endif
+    bilinear_vrow_scalar(r0, r1, w1, i, size, out_row);
+}
+
+
+void ImageRowResizer::nearest_row(const RowSource& source, int32_t y, uint8_t* out_row)
+{
+    const uint8_t* in = source(_y_index[y]);
+    switch (_channels) {
+    case 1:
+        nearest_row_scalar<1>(in, _x_offset.data(), _out_w, _channels, out_row);
+        break;
+    case 3:
+        nearest_row_scalar<3>(in, _x_offset.data(), _out_w, _channels, out_row);
+        break;
+    case 4:
+        nearest_row_scalar<4>(in, _x_offset.data(), _out_w, _channels, out_row);
+        break;
+    default:
+        nearest_row_scalar<0>(in, _x_offset.data(), _out_w, _channels, out_row);
+    }
+}
+
+
+// The input rows covered by the output row are summed first, then the sums are added
+// horizontally and divided by the number of pixels.
+void ImageRowResizer::area_row(const RowSource& source, int32_t y, uint8_t* out_row)
+{
+    const int32_t size = _in_w * _channels;
+    uint16_t* sums = _sums.data();
+    for (int32_t k = 0; k < _area_y; k++) {
+        const uint8_t* in = source(y * _area_y + k);
+        int32_t i = 0;
+#if SYNAP_SIMD_X86
+        if (simd_level() != SimdLevel::none) {
+            i = area_sum_sse41(in, size, k > 0, sums);
+        }
+#elif SYNAP_SIMD_NEON
+        if (simd_level() == SimdLevel::neon) {
+            i = area_sum_neon(in, size, k > 0, sums);
+        }
+#endif
+        area_sum_scalar(in, i, size, k > 0, sums);
+    }
+    const int32_t area = _area_x * _area_y;
+    switch (_channels) {
+    case 1:
+        area_hrow_scalar<1>(sums, _area_x, _area_scale, area, _out_w, _channels, out_row);
+        break;
+    case 3:
+        area_hrow_scalar<3>(sums, _area_x, _area_scale, area, _out_w, _channels, out_row);
+        break;
+    case 4:
+        area_hrow_scalar<4>(sums, _area_x, _area_scale, area, _out_w, _channels, out_row);
+        break;
+    default:
+        area_hrow_scalar<0>(sums, _area_x, _area_scale, area, _out_w, _channels, out_row);
+    }
+}
+
+
+}  // namespace synap
+}  // namespace synaptics
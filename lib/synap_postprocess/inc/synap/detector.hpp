@@ -43,8 +43,13 @@ public:
             /// Empty if no landmark available.
             std::vector<Landmark> landmarks;
 
-            /// Segment mask for instance segmentation models
+            /// Segment mask for instance segmentation models, at the resolution of the mask prototypes.
+            /// Only the pixels inside the bounding box are computed, the others are 0.
+            /// Empty if binary masks are selected with set_mask_encoding().
             Mask mask;
+
+            /// Binary segment mask cropped to the bounding box, if selected with set_mask_encoding()
+            BinaryMask binary_mask;
         };
 
         /// True if detection successful, false if detection failed.
@@ -63,8 +68,16 @@ public:
     /// @param nms: if true apply non-max-suppression to remove duplicate detections
     /// @param iou_threshold: intersection-over-union threshold (used if nms is true)
     /// @param iou_with_min: use min area instead of union to compute intersection-over-union 
+    /// @param nms_per_class: if true non-max-suppression only removes detections overlapping
+    ///                       a detection of the same class
+    /// @param pre_nms_top_k: max number of detections with highest score considered for
+    ///                       non-max-suppression, for each class if nms_per_class is true.
+    ///                       This bounds the postprocessing time in cluttered scenes.
+    ///                       If 0 the value of the "pre_nms_top_k" key in the tensor format is
+    ///                       used if present, otherwise all detections above threshold are considered.
     Detector(float score_threshold = 0.5, int n_max = 0,
-             bool nms = true, float iou_threshold = .5, bool iou_with_min = false);
+             bool nms = true, float iou_threshold = .5, bool iou_with_min = false,
+             bool nms_per_class = false, int pre_nms_top_k = 0);
 
 
     // Destructor
@@ -86,6 +99,15 @@ public:
     /// @return detection results
     Result process(const Tensors& tensors, const Rect& input_rect);
 
+
+    /// Select the format of the segment masks of instance segmentation models.
+    /// Binary masks are much smaller than float masks and faster to serialize.
+    ///
+    /// @param encoding: if not none, segment masks are returned in Item::binary_mask
+    ///                  with the specified encoding instead of Item::mask
+    /// @param threshold: min probability of the pixels set in binary masks
+    void set_mask_encoding(BinaryMask::Encoding encoding, float threshold = 0.5);
+
     // Implementation class
     class Impl;
 
@@ -96,6 +118,10 @@ private:
     bool _nms{};
     float _iou_threshold{};
     bool _iou_with_min{};
+    bool _nms_per_class{};
+    int _pre_nms_top_k{};
+    BinaryMask::Encoding _mask_encoding{BinaryMask::Encoding::none};
+    float _mask_threshold{};
 
     // Implementation details
     std::unique_ptr<Impl> d;
@@ -6,17 +6,25 @@
 #include "synap/logging.hpp"
 #include "synap/network.hpp"
 #include "synap/timer.hpp"
+#include "synap/trace.hpp"
 #include "synap/string_utils.hpp"
 #include "synap/image_convert.hpp"
+#include "synap/simd.hpp"
+#include "synap/thread_pool.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <functional>
 #include <numeric>
 #include <thread>
 
 #if SYNAP_NB_NEON
 #include <arm_neon.h>
 #endif
+#if SYNAP_SIMD_X86
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -66,9 +74,13 @@ public:
     int landmarks_count() const { return _landmarks_count; }
     int visibility() const { return _visibility; }
     uint32_t n_threads() const { return _n_threads; }
+    int pre_nms_top_k() const { return _pre_nms_top_k; }
     bool valid() const { return _valid; }
     bool validate() { _valid = true; return true; }
 
+    /// Execute job(i) for i in [0, count) on n_threads() threads, including the calling one
+    void parallel_for(size_t count, const function<void(size_t)>& job);
+
 private:
     // Base index for the 1st class
     int _index_base{};
@@ -84,6 +96,12 @@ private:
 
     // Number of threads used for parallel processing
     uint32_t _n_threads{};
+
+    // Max number of detections considered for NMS (0: all)
+    int _pre_nms_top_k{};
+
+    // Worker threads for parallel processing, created when first needed
+    unique_ptr<ThreadPool> _workers;
 };
 class DetectorBoxesScores : public Detector::Impl {
 public:
@@ -200,198 +218,540 @@ private:
 };
 
 
-#if SYNAP_NB_NEON
-/// @brief Uses NEON intrinsics to compute dot product along the last axes, producing output of shape [h, w]
-/// @param mat_1 pointer to first matrix, must have shape [n]
-/// @param mat_2 pointer to second matrix, must have shape [h, w, n]
-/// @param output Mask object for storing result
-/// @param n size of last dimension in both matrices
-/// @param h number of rows in second matrix
-/// @param w number of columns in second matrix
-/// @param start_row used to select subset of second matrix
-/// @param end_row used to select subset of second matrix
-static void dot_product_neon(const float* mat_1, const float* mat_2, Mask& output, int n, int h, int w, int start_row, int end_row) 
+namespace {
+
+/// Mask of a detection to be computed
+struct MaskJob {
+    const float* coeffs;    // mask coefficients of the detection
+    int32_t x0, y0, x1, y1; // bounding box in mask coordinates (x1, y1 excluded)
+    float* data;            // output pixel (x0, y0)
+    size_t stride;          // distance between output rows
+};
+
+
+// Compute the columns [x0, x1) of a row of a mask into out[0, x1 - x0) as the dot product of the
+// mask coefficients with the prototypes. For [n, h, w] prototypes the products are accumulated for
+// consecutive pixels at once, for [h, w, n] prototypes the features of each pixel are contiguous.
+// SIMD implementations return the number of columns computed.
+// The [n, h, w] products are accumulated in the same order, so results are the same as scalar code.
+
+/// @param c: mask coefficients [n]
+/// @param p: first prototype of the row, prototypes are [n, h, w]
+/// @param plane: distance between prototypes (h * w)
+void mask_row_chw_scalar(const float* c, const float* p, size_t plane, int32_t n, int32_t x0, int32_t x1, float* out)
 {
-    for (int i = start_row; i < end_row; ++i) {
-        for (int j = 0; j < w; ++j) {
-            float32x4_t sum_vec = vdupq_n_f32(0.0f);  // creates 128-bit vector [0.0f, 0.0f, 0.0f, 0.0f]
-            int k = 0;
-            
-            /* use neon intrinsics to process 4 elements at a time*/
-            for (; k <= n - 4; k += 4) {
-                float32x4_t mat1_vec = vld1q_f32(mat_1 + k); // loads 128-bit vector [mat_1[k], mat_1[k+1], mat_1[k+2], mat_1[k+3]]
-                float32x4_t mat2_vec = vld1q_f32(mat_2 + i * w * n + j * n + k); // loads 128-bit vector [mat_2[i][j][k], mat_2[i][j][k+1], mat_2[i][j][k+2], mat_2[i][j][k+3]]
-                sum_vec = vmlaq_f32(sum_vec, mat1_vec, mat2_vec);  // multiply and accumulate 
-            }
-            /* 
-            sum all values in sum_vec by reducing through pairwise addition
-            equivalent  to:
-            float sum = vget_lane_f32(sum_vec, 0) + vget_lane_f32(sum_vec, 1) + vget_lane_f32(sum_vec, 2) + vget_lane_f32(sum_vec, 3);
-             */
-            float32x2_t sum_vec_low = vget_low_f32(sum_vec); // creates 64-bit vector [sum_vec[0], sum_vec[1]]
-            float32x2_t sum_vec_high = vget_high_f32(sum_vec);  // creates 64-bit vector [sum_vec[2], sum_vec[3]]
-            float32x2_t sum_half = vpadd_f32(sum_vec_low, sum_vec_high); // pair-wise addition, creates 64-bit vector [sum_vec[0] + sum_vec[1], sum_vec[2] + sum_vec[3]]
-            float sum = vget_lane_f32(vpadd_f32(sum_half, sum_half), 0); // pair-wise addtion, computes sum = (sum_vec[0] + sum_vec[1]) + (sum_vec[2] + sum_vec[3])
-
-            /* multiply and sum remaining elems */
-            for (; k < n; ++k) {
-                sum += mat_1[k] * mat_2[i * w * n + j * n + k];
-            }
+    for (int32_t x = x0; x < x1; x++) {
+        float sum = 0.0f;
+        for (int32_t k = 0; k < n; k++) {
+            sum += c[k] * p[k * plane + x];
+        }
+        out[x - x0] = sum;
+    }
+}
+
 
-            output.set_value(i, j, sum);
+/// @param c: mask coefficients [n]
+/// @param p: features of the first pixel of the row, prototypes are [h, w, n]
+void mask_row_hwc_scalar(const float* c, const float* p, int32_t n, int32_t x0, int32_t x1, float* out)
+{
+    for (int32_t x = x0; x < x1; x++) {
+        const float* px = p + size_t(x) * n;
+        float sum = 0.0f;
+        for (int32_t k = 0; k < n; k++) {
+            sum += c[k] * px[k];
         }
-    } 
+        out[x - x0] = sum;
+    }
 }
-#endif
 
-/// @brief Computes dot product along the first or last axes, producing output of shape [h, w]
-/// @param mat_1 pointer to first matrix, must have shape [n] 
-/// @param mat_2 pointer to second matrix, must have shape [n, h, w] or [h, w, n]
-/// @param output Mask object for storing result
-/// @param n size of first or last dimension in both matrices
-/// @param h number of rows in second matrix
-/// @param w number of columns in second matrix
-/// @param start_row used to select subset of second matrix
-/// @param end_row used to select subset of second matrix 
-/// @param is_chw specifies whether second matrix is [n, h, w]
-static void dot_product(const float* mat_1, const float* mat_2, Mask& output, int n, int h, int w, int start_row, int end_row, bool is_chw)
+
+#if SYNAP_SIMD_X86
+
+__attribute__((target("sse4.1")))
+int32_t mask_row_chw_sse41(const float* c, const float* p, size_t plane, int32_t n, int32_t x0, int32_t x1, float* out)
 {
-    for (int i = start_row; i < end_row; ++i) {
-        for (int j = 0; j < w; ++j) {
-            float sum = 0.0f;
-            for (int k = 0; k < n; ++k) {
-                if (is_chw) {
-                    sum += mat_1[k] * mat_2[k * h * w + i * w + j];
-                } else {
-                    sum += mat_1[k] * mat_2[i * w * n + j * n + k];
-                }
-            }
-            output.set_value(i, j, sum);
+    int32_t x = x0;
+    for (; x + 4 <= x1; x += 4) {
+        __m128 sum = _mm_setzero_ps();
+        for (int32_t k = 0; k < n; k++) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(c[k]), _mm_loadu_ps(&p[k * plane + x])));
         }
+        _mm_storeu_ps(&out[x - x0], sum);
     }
+    return x - x0;
 }
 
-/// @brief Calculates mask values via parallelized dot products + NEON intrinsics if available.
-/// @param mask_data Mask data from output0 of seg model
-/// @param mask_protos Mask prototypes from output1 of seg model
-/// @param n_threads Number of threads to use for parallel processing
-/// @param is_chw Whether mask protos have shape [n, h, w] or [h, w, n]
-/// @return A Mask object of shape [mask_data.mask_height, mask_data.mask_width]
-static Mask compute_masks_parallel(const MaskData& mask_data, const float* mask_protos, uint32_t n_threads, bool is_chw)
+
+__attribute__((target("sse4.1")))
+int32_t mask_row_hwc_sse41(const float* c, const float* p, int32_t n, int32_t x0, int32_t x1, float* out)
 {
-    vector<thread> threads;
-    uint32_t n = mask_data.mask_features;
-    uint32_t h = mask_data.mask_height;
-    uint32_t w = mask_data.mask_width;
-    Mask seg_mask {w, h};
-    if (n_threads == 0) {
-#if SYNAP_NB_NEON
-        // can't use NEON for [c, h, w] format as values of c aren't contiguous in memory
-        if (!is_chw)
-            dot_product_neon(mask_data.mask_score_vec.data(), mask_protos, seg_mask, n, h, w, 0, h);
-        else
-            dot_product(mask_data.mask_score_vec.data(), mask_protos, seg_mask, n, h, w, 0, h, is_chw);
-#else
-        dot_product(mask_data.mask_score_vec.data(), mask_protos, seg_mask, n, h, w, 0, h, is_chw);
-#endif
-        return seg_mask;
+    if (n % 4) {
+        return 0;
+    }
+    for (int32_t x = x0; x < x1; x++) {
+        const float* px = p + size_t(x) * n;
+        __m128 sum = _mm_setzero_ps();
+        for (int32_t k = 0; k < n; k += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&c[k]), _mm_loadu_ps(&px[k])));
+        }
+        sum = _mm_hadd_ps(sum, sum);
+        out[x - x0] = _mm_cvtss_f32(_mm_hadd_ps(sum, sum));
     }
-    int rows_per_thread = h / n_threads;
-    int remaining_rows = h % n_threads;
-    int start_row = 0;
-    for (int i = 0; i < n_threads; ++i) {
-        int end_row = start_row + rows_per_thread + (i < remaining_rows ? 1 : 0);
+    return x1 - x0;
+}
 
-#if SYNAP_NB_NEON
-        // can't use NEON for [c, h, w] format as values of c aren't contiguous in memory
-        if (!is_chw)
-            threads.push_back(thread(dot_product_neon, mask_data.mask_score_vec.data(), mask_protos, ref(seg_mask), n, h, w, start_row, end_row));
-        else
-            threads.push_back(thread(dot_product, mask_data.mask_score_vec.data(), mask_protos, ref(seg_mask), n, h, w, start_row, end_row, is_chw));
-#else
-        threads.push_back(thread(dot_product, mask_data.mask_score_vec.data(), mask_protos, ref(seg_mask), n, h, w, start_row, end_row, is_chw));
-#endif
-        start_row = end_row;
+
+__attribute__((target("avx2")))
+int32_t mask_row_chw_avx2(const float* c, const float* p, size_t plane, int32_t n, int32_t x0, int32_t x1, float* out)
+{
+    int32_t x = x0;
+    for (; x + 8 <= x1; x += 8) {
+        __m256 sum = _mm256_setzero_ps();
+        for (int32_t k = 0; k < n; k++) {
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(c[k]), _mm256_loadu_ps(&p[k * plane + x])));
+        }
+        _mm256_storeu_ps(&out[x - x0], sum);
     }
+    return x - x0;
+}
 
-    for (auto& thread : threads) {
-        thread.join();
+
+__attribute__((target("avx2")))
+int32_t mask_row_hwc_avx2(const float* c, const float* p, int32_t n, int32_t x0, int32_t x1, float* out)
+{
+    if (n % 8) {
+        return 0;
+    }
+    for (int32_t x = x0; x < x1; x++) {
+        const float* px = p + size_t(x) * n;
+        __m256 sum = _mm256_setzero_ps();
+        for (int32_t k = 0; k < n; k += 8) {
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(&c[k]), _mm256_loadu_ps(&px[k])));
+        }
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+        s = _mm_hadd_ps(s, s);
+        out[x - x0] = _mm_cvtss_f32(_mm_hadd_ps(s, s));
     }
+    return x1 - x0;
+}
+
+#endif  // SYNAP_SIMD_X86
+
 
-    return seg_mask;
+#if SYNAP_SIMD_NEON
+
+int32_t mask_row_chw_neon(const float* c, const float* p, size_t plane, int32_t n, int32_t x0, int32_t x1, float* out)
+{
+    int32_t x = x0;
+    for (; x + 4 <= x1; x += 4) {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (int32_t k = 0; k < n; k++) {
+            sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(&p[k * plane + x]), c[k]));
+        }
+        vst1q_f32(&out[x - x0], sum);
+    }
+    return x - x0;
 }
 
 
-/// Determines whether the detection should be kept or not.
-///
-/// Detection is discarded if the box overlap with any one already selected is above threshold.
-/// @param curr_idx: index of detectiont to be checked
-/// @param detections: all detections
-/// @param selected_indices: indexes of selected detections
-/// @param iou_threshold: discard if box overlap above this threshold
-/// @param use_min: use minimum area instead of intersection
-/// @return true to keep, false to discard
-static bool keep_detection(int32_t curr_idx, const vector<Detection>& detections,
-                           const vector<int32_t>& selected_indices, float iou_threshold, bool use_min)
+int32_t mask_row_hwc_neon(const float* c, const float* p, int32_t n, int32_t x0, int32_t x1, float* out)
+{
+    if (n % 4) {
+        return 0;
+    }
+    for (int32_t x = x0; x < x1; x++) {
+        const float* px = p + size_t(x) * n;
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (int32_t k = 0; k < n; k += 4) {
+            sum = vmlaq_f32(sum, vld1q_f32(&c[k]), vld1q_f32(&px[k]));
+        }
+        out[x - x0] = vaddvq_f32(sum);
+    }
+    return x1 - x0;
+}
+
+#endif  // SYNAP_SIMD_NEON
+
+
+/// Compute rows [y0, y1) of a mask inside the bounding box
+void mask_rows(const MaskJob& job, const float* protos, int32_t n, int32_t h, int32_t w, bool is_chw,
+               int32_t y0, int32_t y1)
+{
+    const size_t plane = size_t(h) * w;
+#if SYNAP_SIMD_X86 || SYNAP_SIMD_NEON
+    const SimdLevel level = simd_level();
+#endif
+    for (int32_t y = y0; y < y1; y++) {
+        float* out = job.data + size_t(y - job.y0) * job.stride;
+        int32_t done = 0;
+        if (is_chw) {
+            const float* p = protos + size_t(y) * w;
+#if SYNAP_SIMD_X86
+            if (level == SimdLevel::avx2) {
+                done = mask_row_chw_avx2(job.coeffs, p, plane, n, job.x0, job.x1, out);
+            }
+            else if (level == SimdLevel::sse41) {
+                done = mask_row_chw_sse41(job.coeffs, p, plane, n, job.x0, job.x1, out);
+            }
+#elif SYNAP_SIMD_NEON
+            if (level == SimdLevel::neon) {
+                done = mask_row_chw_neon(job.coeffs, p, plane, n, job.x0, job.x1, out);
+            }
+#endif
+            mask_row_chw_scalar(job.coeffs, p, plane, n, job.x0 + done, job.x1, out + done);
+        }
+        else {
+            const float* p = protos + size_t(y) * w * n;
+#if SYNAP_SIMD_X86
+            if (level == SimdLevel::avx2 && n % 8 == 0) {
+                done = mask_row_hwc_avx2(job.coeffs, p, n, job.x0, job.x1, out);
+            }
+            else if (level != SimdLevel::none) {
+                done = mask_row_hwc_sse41(job.coeffs, p, n, job.x0, job.x1, out);
+            }
+#elif SYNAP_SIMD_NEON
+            if (level == SimdLevel::neon) {
+                done = mask_row_hwc_neon(job.coeffs, p, n, job.x0, job.x1, out);
+            }
+#endif
+            mask_row_hwc_scalar(job.coeffs, p, n, job.x0 + done, job.x1, out + done);
+        }
+    }
+}
+
+}  // namespace
+
+
+/// @brief Calculates the masks of all the detections as a single [n_det, n] x [n, h * w] product.
+/// Only the pixels inside the bounding box of each detection are computed, the others are 0.
+/// The work is split in bands of rows executed in parallel.
+/// @param jobs Masks to be computed
+/// @param mask_protos Mask prototypes from output1 of seg model
+/// @param n Number of mask features
+/// @param h Mask height
+/// @param w Mask width
+/// @param is_chw Whether mask protos have shape [n, h, w] or [h, w, n]
+/// @param impl Detector implementation providing the worker threads
+static void compute_masks(const vector<MaskJob>& jobs, const float* mask_protos, int32_t n, int32_t h, int32_t w,
+                          bool is_chw, Detector::Impl& impl)
 {
-    const Box* curr_box = &detections[curr_idx].box;
-    float curr_box_area = (curr_box->br.x - curr_box->tl.x) * (curr_box->br.y - curr_box->tl.y);
-
-    // Check if any of the selected boxes has high overlap with the current one
-    for (int32_t i = 0; i < selected_indices.size(); i++) {
-        // Calculate intersection width and height.
-        const Box* box = &detections[selected_indices[i]].box;
-        float iw = min(curr_box->br.x, box->br.x) - max(curr_box->tl.x, box->tl.x);
-        float ih = min(curr_box->br.y, box->br.y) - max(curr_box->tl.y, box->tl.y);
-        float box_area = (box->br.x - box->tl.x) * (box->br.y - box->tl.y);
-        // Calculate IOU and compare with the threshold for non-zero IOUs only.
+    // Rows per band, enough to amortize the scheduling overhead
+    constexpr int32_t band_rows = 8;
+    struct Band {
+        size_t job;
+        int32_t y0, y1;
+    };
+    vector<Band> bands;
+    for (size_t j = 0; j < jobs.size(); j++) {
+        if (jobs[j].x0 >= jobs[j].x1) {
+            continue;
+        }
+        for (int32_t y = jobs[j].y0; y < jobs[j].y1; y += band_rows) {
+            bands.push_back({j, y, min(y + band_rows, jobs[j].y1)});
+        }
+    }
+    impl.parallel_for(bands.size(), [&](size_t i) {
+        const Band& b = bands[i];
+        mask_rows(jobs[b.job], mask_protos, n, h, w, is_chw, b.y0, b.y1);
+    });
+}
+
+
+namespace {
+
+/// Box to be compared with the boxes already selected by non-max-suppression
+struct NmsQuery {
+    float x1, y1, x2, y2;
+    float area;
+    int32_t class_index;
+};
+
+
+/// Options of non-max-suppression
+struct NmsOptions {
+    float iou_threshold;
+    bool use_min;
+    bool per_class;
+};
+
+
+/// Boxes selected by non-max-suppression.
+/// Stored as structure of arrays so that a new box can be compared with several of them at a time.
+struct NmsBoxes {
+    vector<float> x1, y1, x2, y2;
+    vector<float> area;
+    vector<int32_t> class_index;
+
+    size_t size() const { return x1.size(); }
+
+    void add(const NmsQuery& q)
+    {
+        x1.push_back(q.x1);
+        y1.push_back(q.y1);
+        x2.push_back(q.x2);
+        y2.push_back(q.y2);
+        area.push_back(q.area);
+        class_index.push_back(q.class_index);
+    }
+};
+
+
+/// Check the boxes from first for an overlap above threshold with the query box.
+/// IOU is computed only if the intersection is not empty, and only with the boxes of the same
+/// class if per-class suppression is enabled.
+/// @return true if overlap found
+bool nms_overlap_scalar(const NmsBoxes& b, size_t first, const NmsQuery& q, const NmsOptions& opt)
+{
+    for (size_t i = first; i < b.size(); i++) {
+        if (opt.per_class && b.class_index[i] != q.class_index) {
+            continue;
+        }
+        float iw = min(q.x2, b.x2[i]) - max(q.x1, b.x1[i]);
+        float ih = min(q.y2, b.y2[i]) - max(q.y1, b.y1[i]);
         if (ih > 0.0 && iw > 0.0) {
             float ia = iw * ih;
-            float ua = use_min ? min(curr_box_area, box_area) : curr_box_area + box_area - ia;
-            float iou = ia / ua;
-            if (iou > iou_threshold) {
-                return false;
+            float ua = opt.use_min ? min(q.area, b.area[i]) : q.area + b.area[i] - ia;
+            if (ia / ua > opt.iou_threshold) {
+                return true;
             }
         }
     }
+    return false;
+}
 
-    // Low overlap with all the detections already selected
-    return true;
+
+// SIMD implementations check blocks of boxes, they return true if overlap found,
+// otherwise the number of boxes checked in *checked.
+// IOU is computed with the same operations as in the scalar code, so results are the same.
+
+#if SYNAP_SIMD_X86
+
+__attribute__((target("sse4.1")))
+bool nms_overlap_sse41(const NmsBoxes& b, const NmsQuery& q, const NmsOptions& opt, size_t* checked)
+{
+    const __m128 qx1 = _mm_set1_ps(q.x1);
+    const __m128 qy1 = _mm_set1_ps(q.y1);
+    const __m128 qx2 = _mm_set1_ps(q.x2);
+    const __m128 qy2 = _mm_set1_ps(q.y2);
+    const __m128 qarea = _mm_set1_ps(q.area);
+    const __m128i qclass = _mm_set1_epi32(q.class_index);
+    const __m128 thr = _mm_set1_ps(opt.iou_threshold);
+    const __m128 zero = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= b.size(); i += 4) {
+        const __m128 iw = _mm_sub_ps(_mm_min_ps(qx2, _mm_loadu_ps(&b.x2[i])), _mm_max_ps(qx1, _mm_loadu_ps(&b.x1[i])));
+        const __m128 ih = _mm_sub_ps(_mm_min_ps(qy2, _mm_loadu_ps(&b.y2[i])), _mm_max_ps(qy1, _mm_loadu_ps(&b.y1[i])));
+        const __m128 area = _mm_loadu_ps(&b.area[i]);
+        const __m128 ia = _mm_mul_ps(iw, ih);
+        const __m128 ua = opt.use_min ? _mm_min_ps(qarea, area) : _mm_sub_ps(_mm_add_ps(qarea, area), ia);
+        __m128 mask = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(ih, zero), _mm_cmpgt_ps(iw, zero)),
+                                 _mm_cmpgt_ps(_mm_div_ps(ia, ua), thr));
+        if (opt.per_class) {
+            const __m128i cls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b.class_index[i]));
+            mask = _mm_and_ps(mask, _mm_castsi128_ps(_mm_cmpeq_epi32(cls, qclass)));
+        }
+        if (_mm_movemask_ps(mask)) {
+            return true;
+        }
+    }
+    *checked = i;
+    return false;
+}
+
+
+__attribute__((target("avx2")))
+bool nms_overlap_avx2(const NmsBoxes& b, const NmsQuery& q, const NmsOptions& opt, size_t* checked)
+{
+    const __m256 qx1 = _mm256_set1_ps(q.x1);
+    const __m256 qy1 = _mm256_set1_ps(q.y1);
+    const __m256 qx2 = _mm256_set1_ps(q.x2);
+    const __m256 qy2 = _mm256_set1_ps(q.y2);
+    const __m256 qarea = _mm256_set1_ps(q.area);
+    const __m256i qclass = _mm256_set1_epi32(q.class_index);
+    const __m256 thr = _mm256_set1_ps(opt.iou_threshold);
+    const __m256 zero = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= b.size(); i += 8) {
+        const __m256 iw = _mm256_sub_ps(_mm256_min_ps(qx2, _mm256_loadu_ps(&b.x2[i])),
+                                        _mm256_max_ps(qx1, _mm256_loadu_ps(&b.x1[i])));
+        const __m256 ih = _mm256_sub_ps(_mm256_min_ps(qy2, _mm256_loadu_ps(&b.y2[i])),
+                                        _mm256_max_ps(qy1, _mm256_loadu_ps(&b.y1[i])));
+        const __m256 area = _mm256_loadu_ps(&b.area[i]);
+        const __m256 ia = _mm256_mul_ps(iw, ih);
+        const __m256 ua = opt.use_min ? _mm256_min_ps(qarea, area) : _mm256_sub_ps(_mm256_add_ps(qarea, area), ia);
+        __m256 mask = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(ih, zero, _CMP_GT_OQ),
+                                                  _mm256_cmp_ps(iw, zero, _CMP_GT_OQ)),
+                                    _mm256_cmp_ps(_mm256_div_ps(ia, ua), thr, _CMP_GT_OQ));
+        if (opt.per_class) {
+            const __m256i cls = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b.class_index[i]));
+            mask = _mm256_and_ps(mask, _mm256_castsi256_ps(_mm256_cmpeq_epi32(cls, qclass)));
+        }
+        if (_mm256_movemask_ps(mask)) {
+            return true;
+        }
+    }
+    *checked = i;
+    return false;
+}
+
+#endif  // SYNAP_SIMD_X86
+
+
+#if SYNAP_SIMD_NEON
+
+bool nms_overlap_neon(const NmsBoxes& b, const NmsQuery& q, const NmsOptions& opt, size_t* checked)
+{
+    const float32x4_t qx1 = vdupq_n_f32(q.x1);
+    const float32x4_t qy1 = vdupq_n_f32(q.y1);
+    const float32x4_t qx2 = vdupq_n_f32(q.x2);
+    const float32x4_t qy2 = vdupq_n_f32(q.y2);
+    const float32x4_t qarea = vdupq_n_f32(q.area);
+    const int32x4_t qclass = vdupq_n_s32(q.class_index);
+    const float32x4_t thr = vdupq_n_f32(opt.iou_threshold);
+    const float32x4_t zero = vdupq_n_f32(0);
+    size_t i = 0;
+    for (; i + 4 <= b.size(); i += 4) {
+        const float32x4_t iw = vsubq_f32(vminq_f32(qx2, vld1q_f32(&b.x2[i])), vmaxq_f32(qx1, vld1q_f32(&b.x1[i])));
+        const float32x4_t ih = vsubq_f32(vminq_f32(qy2, vld1q_f32(&b.y2[i])), vmaxq_f32(qy1, vld1q_f32(&b.y1[i])));
+        const float32x4_t area = vld1q_f32(&b.area[i]);
+        const float32x4_t ia = vmulq_f32(iw, ih);
+        const float32x4_t ua = opt.use_min ? vminq_f32(qarea, area) : vsubq_f32(vaddq_f32(qarea, area), ia);
+        uint32x4_t mask = vandq_u32(vandq_u32(vcgtq_f32(ih, zero), vcgtq_f32(iw, zero)),
+                                    vcgtq_f32(vdivq_f32(ia, ua), thr));
+        if (opt.per_class) {
+            mask = vandq_u32(mask, vceqq_s32(vld1q_s32(&b.class_index[i]), qclass));
+        }
+        if (vmaxvq_u32(mask)) {
+            return true;
+        }
+    }
+    *checked = i;
+    return false;
+}
+
+#endif  // SYNAP_SIMD_NEON
+
+
+/// Check if a box overlaps any of the boxes already selected
+bool nms_overlap(const NmsBoxes& b, const NmsQuery& q, const NmsOptions& opt)
+{
+    size_t checked = 0;
+#if SYNAP_SIMD_X86
+    const SimdLevel level = simd_level();
+    if (level == SimdLevel::avx2 && nms_overlap_avx2(b, q, opt, &checked)) {
+        return true;
+    }
+    if (level == SimdLevel::sse41 && nms_overlap_sse41(b, q, opt, &checked)) {
+        return true;
+    }
+#elif SYNAP_SIMD_NEON
+    if (simd_level() == SimdLevel::neon && nms_overlap_neon(b, q, opt, &checked)) {
+        return true;
+    }
+#endif
+    return nms_overlap_scalar(b, checked, q, opt);
+}
+
+}  // namespace
+
+
+/// Keep only the top_k highest scoring detections, globally or for each class.
+/// This is done in linear time, the indexes kept are not sorted.
+/// @param indices: indexes of the detections, updated with the indexes kept
+/// @param detections: all detections
+/// @param top_k: number of detections to keep
+/// @param per_class: keep top_k detections for each class
+/// @param higher: comparison function, true if the first detection has a higher score
+template <typename Compare>
+static void limit_candidates(vector<int32_t>& indices, const vector<Detection>& detections, size_t top_k,
+                             bool per_class, Compare higher)
+{
+    if (!per_class) {
+        if (indices.size() > top_k) {
+            nth_element(begin(indices), begin(indices) + top_k, end(indices), higher);
+            indices.resize(top_k);
+        }
+        return;
+    }
+
+    // Group the detections by class (counting sort), then keep the top_k of each group
+    int32_t class_count = 0;
+    for (const Detection& d : detections) {
+        class_count = max(class_count, d.class_index + 1);
+    }
+    vector<size_t> group_start(class_count + 1);
+    for (const Detection& d : detections) {
+        group_start[d.class_index + 1]++;
+    }
+    partial_sum(begin(group_start), end(group_start), begin(group_start));
+    vector<size_t> group_end(begin(group_start), end(group_start) - 1);
+    vector<int32_t> grouped(indices.size());
+    for (int32_t i : indices) {
+        grouped[group_end[detections[i].class_index]++] = i;
+    }
+    indices.clear();
+    for (int32_t c = 0; c < class_count; c++) {
+        auto first = begin(grouped) + group_start[c];
+        auto last = begin(grouped) + group_end[c];
+        if (size_t(last - first) > top_k) {
+            nth_element(first, first + top_k, last, higher);
+            last = first + top_k;
+        }
+        indices.insert(end(indices), first, last);
+    }
 }
 
 
 /// Select a subset of detections in descending order of score.
 ///
 /// If NonMaxSuppression is enabled prunes away those with high intersection-over-union (IOU)
-/// overlap with previously selected boxes.
+/// overlap with previously selected boxes. The detections are sorted once, then each one is
+/// compared with the boxes selected so far, several boxes at a time using SIMD instructions.
 /// @param max_detections: maximum number of detections to be selected (0: all)
 /// @param detections: all detections
 /// @param nms: if true apply NMS, else just pick the detections with highest score
 /// @param iou_threshold: max allowed overlap for IOU in the range [0, 1]
 /// @param iou_with_min: use min to compute IOU
+/// @param per_class: only suppress detections overlapping a selected detection of the same class
+/// @param pre_nms_top_k: only the pre_nms_top_k detections with highest score are considered,
+///                       for each class if per_class is true (0: all)
 ///
 /// @return: indexes of selected boxes in the 'boxes' array.
 static vector<int32_t> select(int32_t max_detections, const vector<Detection>& detections, bool nms,
-                              float iou_threshold, bool iou_with_min)
+                              float iou_threshold, bool iou_with_min, bool per_class, int32_t pre_nms_top_k)
 {
-    // Sort detections in order of decreasing scores
-    auto compare_score = [&detections](int32_t i, int32_t j) {
-        return detections[i].score < detections[j].score;
+    // Sort detections in order of decreasing scores (by index for the same score)
+    const auto higher = [&detections](int32_t i, int32_t j) {
+        const float si = detections[i].score;
+        const float sj = detections[j].score;
+        return si > sj || (si == sj && i < j);
     };
     vector<int32_t> indices(detections.size());
     iota(begin(indices), end(indices), 0);
-    make_heap(begin(indices), end(indices), compare_score);
+    if (pre_nms_top_k > 0) {
+        limit_candidates(indices, detections, pre_nms_top_k, per_class && nms, higher);
+    }
+    sort(begin(indices), end(indices), higher);
+    const size_t max_count = max_detections > 0 ? max_detections : indices.size();
+    if (!nms) {
+        indices.resize(min(max_count, indices.size()));
+        return indices;
+    }
 
-    // Generate indices of top scoring boxes that overlap less than the iou_threshold.
+    // Select the top scoring boxes that overlap less than the iou_threshold
+    const NmsOptions opt{iou_threshold, iou_with_min, per_class};
+    NmsBoxes selected_boxes;
     vector<int32_t> selected_indexes;
-    while (!indices.empty() && (max_detections == 0 || selected_indexes.size() < max_detections)) {
-        if (!nms || keep_detection(indices.front(), detections, selected_indexes, iou_threshold, iou_with_min)) {
-            selected_indexes.push_back(indices.front());
+    for (size_t i = 0; i < indices.size() && selected_indexes.size() < max_count; i++) {
+        const Detection& d = detections[indices[i]];
+        const Box& box = d.box;
+        const NmsQuery q{box.tl.x, box.tl.y, box.br.x, box.br.y,
+                         (box.br.x - box.tl.x) * (box.br.y - box.tl.y), d.class_index};
+        if (!nms_overlap(selected_boxes, q, opt)) {
+            selected_boxes.add(q);
+            selected_indexes.push_back(indices[i]);
         }
-        pop_heap(begin(indices), end(indices), compare_score);
-        indices.pop_back();
-    };
-
+    }
     return selected_indexes;
 }
 
@@ -464,6 +824,223 @@ inline int get_index_max(const float* v, size_t size)
 }
 
 
+/// Max number of anchors processed together when decoding channel-major tensors
+constexpr size_t class_max_block = 256;
+
+
+/// Score threshold applied directly to the raw data of a 8-bits quantized tensor.
+/// Allows to discard candidates without converting the whole tensor to float,
+/// only the candidates above threshold have then to be dequantized.
+class QuantizedScores {
+public:
+    /// @param tensor: tensor containing the scores
+    /// @param threshold: score threshold in the float domain
+    /// @return true if the threshold can be applied to the raw data of the tensor
+    bool init(const Tensor& tensor, float threshold)
+    {
+        _data = tensor.data();
+        _signed = tensor.data_type() == DataType::int8;
+        return _data && tensor.quantized_threshold(threshold, &_threshold);
+    }
+
+    /// @return true if the score at the specified index is below threshold
+    bool below(size_t index) const
+    {
+        return (_signed ? static_cast<const int8_t*>(_data)[index] :
+                          static_cast<const uint8_t*>(_data)[index]) < _threshold;
+    }
+
+    /// @param offset: index of the first score
+    /// @param count: number of scores
+    /// @param stride: distance between scores
+    /// @return true if all the scores are below threshold
+    bool all_below(size_t offset, size_t count, size_t stride = 1) const
+    {
+        return (_signed ? max_value(static_cast<const int8_t*>(_data) + offset, count, stride) :
+                          max_value(static_cast<const uint8_t*>(_data) + offset, count, stride)) < _threshold;
+    }
+
+    /// Check a block of consecutive anchors of a channel-major tensor.
+    /// The score rows are scanned sequentially instead of reading the scores of each anchor
+    /// with a stride, this is equivalent to calling all_below() for each anchor.
+    /// @param offset: index of the first score of the first anchor
+    /// @param rows: number of scores of each anchor
+    /// @param stride: distance between score rows
+    /// @param count: number of anchors, at most class_max_block
+    /// @param[out] below: for each anchor true if all its scores are below threshold
+    void all_below(size_t offset, size_t rows, size_t stride, size_t count, bool* below) const
+    {
+        if (_signed) {
+            rows_below(static_cast<const int8_t*>(_data) + offset, rows, stride, count, below);
+        }
+        else {
+            rows_below(static_cast<const uint8_t*>(_data) + offset, rows, stride, count, below);
+        }
+    }
+
+private:
+    template<typename T>
+    void rows_below(const T* data, size_t rows, size_t stride, size_t count, bool* below) const
+    {
+        T max_v[class_max_block];
+        fill(max_v, max_v + count, numeric_limits<T>::min());
+        for (size_t r = 0; r < rows; r++, data += stride) {
+            for (size_t i = 0; i < count; i++) {
+                max_v[i] = max(max_v[i], data[i]);
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            below[i] = max_v[i] < _threshold;
+        }
+    }
+
+    template<typename T>
+    static int32_t max_value(const T* data, size_t count, size_t stride)
+    {
+        T max_v = numeric_limits<T>::min();
+        if (stride == 1) {
+            for (size_t i = 0; i < count; i++) {
+                max_v = max(max_v, data[i]);
+            }
+        }
+        else {
+            for (size_t i = 0; i < count; i++) {
+                max_v = max(max_v, data[i * stride]);
+            }
+        }
+        return max_v;
+    }
+
+    const void* _data{};
+    bool _signed{};
+    int32_t _threshold{};
+};
+
+
+namespace {
+
+// Max class score of a block of consecutive anchors of a channel-major tensor [1, rows, N].
+// The class scores of an anchor are N items apart, so instead of reading them with a stride
+// (a cache miss for each score) the class rows are scanned sequentially, updating the max score
+// and class index of all the anchors of the block at once.
+// The max is updated only if a score is strictly greater, so that the first max is selected
+// as done by get_index_max() on the scores of each anchor.
+// max_score[] and max_index[] must be initialized by the caller, SIMD implementations
+// return the number of anchors processed.
+
+void class_max_scalar(const float* scores, size_t num_classes, size_t stride, size_t first, size_t count,
+                      float* max_score, int32_t* max_index)
+{
+    for (size_t c = 0; c < num_classes; c++, scores += stride) {
+        for (size_t i = first; i < count; i++) {
+            if (scores[i] > max_score[i]) {
+                max_score[i] = scores[i];
+                max_index[i] = c;
+            }
+        }
+    }
+}
+
+
+#if SYNAP_SIMD_X86
+
+__attribute__((target("sse4.1")))
+size_t class_max_sse41(const float* scores, size_t num_classes, size_t stride, size_t count,
+                       float* max_score, int32_t* max_index)
+{
+    const size_t n = count & ~size_t(3);
+    for (size_t c = 0; c < num_classes; c++, scores += stride) {
+        const __m128 cls = _mm_castsi128_ps(_mm_set1_epi32(c));
+        for (size_t i = 0; i < n; i += 4) {
+            const __m128 v = _mm_loadu_ps(&scores[i]);
+            const __m128 m = _mm_loadu_ps(&max_score[i]);
+            const __m128 gt = _mm_cmpgt_ps(v, m);
+            __m128i* index = reinterpret_cast<__m128i*>(&max_index[i]);
+            _mm_storeu_ps(&max_score[i], _mm_blendv_ps(m, v, gt));
+            _mm_storeu_si128(index, _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(_mm_loadu_si128(index)), cls, gt)));
+        }
+    }
+    return n;
+}
+
+
+__attribute__((target("avx2")))
+size_t class_max_avx2(const float* scores, size_t num_classes, size_t stride, size_t count,
+                      float* max_score, int32_t* max_index)
+{
+    const size_t n = count & ~size_t(7);
+    for (size_t c = 0; c < num_classes; c++, scores += stride) {
+        const __m256 cls = _mm256_castsi256_ps(_mm256_set1_epi32(c));
+        for (size_t i = 0; i < n; i += 8) {
+            const __m256 v = _mm256_loadu_ps(&scores[i]);
+            const __m256 m = _mm256_loadu_ps(&max_score[i]);
+            const __m256 gt = _mm256_cmp_ps(v, m, _CMP_GT_OQ);
+            __m256i* index = reinterpret_cast<__m256i*>(&max_index[i]);
+            _mm256_storeu_ps(&max_score[i], _mm256_blendv_ps(m, v, gt));
+            _mm256_storeu_si256(index, _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(_mm256_loadu_si256(index)), cls, gt)));
+        }
+    }
+    return n;
+}
+
+#endif  // SYNAP_SIMD_X86
+
+
+#if SYNAP_SIMD_NEON
+
+size_t class_max_neon(const float* scores, size_t num_classes, size_t stride, size_t count,
+                      float* max_score, int32_t* max_index)
+{
+    const size_t n = count & ~size_t(3);
+    for (size_t c = 0; c < num_classes; c++, scores += stride) {
+        const int32x4_t cls = vdupq_n_s32(c);
+        for (size_t i = 0; i < n; i += 4) {
+            const float32x4_t v = vld1q_f32(&scores[i]);
+            const float32x4_t m = vld1q_f32(&max_score[i]);
+            const uint32x4_t gt = vcgtq_f32(v, m);
+            vst1q_f32(&max_score[i], vbslq_f32(gt, v, m));
+            vst1q_s32(&max_index[i], vbslq_s32(gt, cls, vld1q_s32(&max_index[i])));
+        }
+    }
+    return n;
+}
+
+#endif  // SYNAP_SIMD_NEON
+
+
+/// Get the max class score of a block of consecutive anchors of a channel-major tensor.
+/// Same results as get_index_max() on the scores of each anchor.
+/// @param scores: score of the first class of the first anchor
+/// @param num_classes: number of classes
+/// @param stride: distance between class rows (number of anchors in the tensor)
+/// @param count: number of anchors in the block
+/// @param[out] max_score: max score of each anchor
+/// @param[out] max_index: class index of the max score of each anchor, -1 if none
+void class_max(const float* scores, size_t num_classes, size_t stride, size_t count,
+               float* max_score, int32_t* max_index)
+{
+    fill(max_score, max_score + count, numeric_limits<float>::min());
+    fill(max_index, max_index + count, -1);
+    size_t done = 0;
+#if SYNAP_SIMD_X86
+    const SimdLevel level = simd_level();
+    if (level == SimdLevel::avx2) {
+        done = class_max_avx2(scores, num_classes, stride, count, max_score, max_index);
+    }
+    else if (level == SimdLevel::sse41) {
+        done = class_max_sse41(scores, num_classes, stride, count, max_score, max_index);
+    }
+#elif SYNAP_SIMD_NEON
+    if (simd_level() == SimdLevel::neon) {
+        done = class_max_neon(scores, num_classes, stride, count, max_score, max_index);
+    }
+#endif
+    class_max_scalar(scores, num_classes, stride, done, count, max_score, max_index);
+}
+
+}  // namespace
+
+
 bool Detector::Impl::init(const Tensors& tensors)
 {
     if (tensors.size() == 0) {
@@ -483,6 +1060,8 @@ bool Detector::Impl::init(const Tensors& tensors)
     _landmarks_count = format_parse::get_int(tensors[0].format(), "landmarks", 0);
     // Get visibility detected
     _visibility = format_parse::get_int(tensors[0].format(), "visibility", 0);
+    // Get max number of detections considered for NMS
+    _pre_nms_top_k = format_parse::get_int(tensors[0].format(), "pre_nms_top_k", 0);
 
     // Get number of threads to use for parallel processing
     uint32_t hw_threads = thread::hardware_concurrency();
@@ -504,6 +1083,28 @@ bool Detector::Impl::init(const Tensors& tensors)
 }
 
 
+void Detector::Impl::parallel_for(size_t count, const function<void(size_t)>& job)
+{
+    if (_n_threads > 1 && count > 1 && !_workers) {
+        _workers.reset(new ThreadPool(_n_threads - 1));
+    }
+    atomic<size_t> next{0};
+    const auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            job(i);
+        }
+    };
+    const size_t job_count = _workers ? min(count, _workers->size() + 1) : 1;
+    for (size_t j = 1; j < job_count; j++) {
+        _workers->post(worker);
+    }
+    worker();
+    if (_workers) {
+        _workers->wait();
+    }
+}
+
+
 bool DetectorBoxesScores::init(const Tensors& tensors)
 {
     if (tensors.size() != 2) {
@@ -539,18 +1140,37 @@ vector<Detection> DetectorBoxesScores::get_detections(float min_score, const Ten
     auto num_classes = classification_tensor.shape().at(2);
     LOGV << "Detector boxes: " << num_boxes << " classes: " << num_classes;
 
-    // Create a detection for each box with max score above threshold
-    const float* scores = classification_tensor.as_float();
-    const float* deltas = regression_tensor.as_float();
+    // Create a detection for each box with max score above threshold.
+    // With quantized scores only the boxes with some score above threshold are dequantized.
+    QuantizedScores qscores;
+    const bool quantized = qscores.init(classification_tensor, min_score);
+    const float* all_scores = quantized ? nullptr : classification_tensor.as_float();
+    const float* all_deltas = quantized ? nullptr : regression_tensor.as_float();
+    vector<float> box_scores(quantized ? num_classes : 0);
+    float box_deltas[4];
 
     vector<Detection> dv;
-    for (int32_t i = 0; i < num_boxes; i++, scores += num_classes) {
+    for (int32_t i = 0; i < num_boxes; i++) {
+        const float* scores = box_scores.data();
+        const float* deltas = box_deltas;
+        if (!quantized) {
+            scores = &all_scores[i * num_classes];
+            deltas = &all_deltas[i * 4];
+        }
+        else if (qscores.all_below(i * num_classes, num_classes)) {
+            continue;
+        }
+        else {
+            classification_tensor.as_float(box_scores.data(), i * num_classes, num_classes);
+            regression_tensor.as_float(box_deltas, i * 4, 4);
+        }
+
         // Find the class with the highest score
         int c = get_index_max(scores, num_classes);
 
         // Create a Detection for this box if score above threshold
         if (c >= 0 && scores[c] >= min_score) {
-            dv.push_back({scores[c], c, get_box(&deltas[i * 4], &_anchors[i * 4], in_dim)});
+            dv.push_back({scores[c], c, get_box(deltas, &_anchors[i * 4], in_dim)});
         }
     }
     
@@ -770,12 +1390,27 @@ vector<Detection> DetectorYolov5::get_detections(float min_score, const Tensors&
             LOGE << "Invalid tensor shape: " << tensor.shape();
             return {};
         }
-        // Create a detection for each box with max score above threshold
-        const float* detections = tensor.as_float();
+        // Create a detection for each box with max score above threshold.
+        // With quantized data only the boxes with confidence above threshold are dequantized.
+        QuantizedScores qscores;
+        const bool quantized = qscores.init(tensor, min_score);
+        const float* all_detections = quantized ? nullptr : tensor.as_float();
         auto num_boxes = tensor.shape().at(1);
         size_t det_sz = sizeof(RawDetection) / sizeof(float) + landmarks_count() * 2 + num_classes;
+        constexpr size_t confidence_index = offsetof(RawDetection, confidence) / sizeof(float);
+        vector<float> detection_buf(quantized ? det_sz : 0);
         LOGV << "Detector boxes: " << num_boxes;
-        for (int32_t i = 0; i < num_boxes; i++, detections += det_sz) {
+        for (int32_t i = 0; i < num_boxes; i++) {
+            const float* detections = detection_buf.data();
+            if (!quantized) {
+                detections = &all_detections[i * det_sz];
+            }
+            else if (qscores.below(i * det_sz + confidence_index)) {
+                continue;
+            }
+            else {
+                tensor.as_float(detection_buf.data(), i * det_sz, det_sz);
+            }
             const RawDetection* detection = reinterpret_cast<const RawDetection*>(detections);
             if (detection->confidence < min_score) {
                 // Overall confidence is too low
@@ -850,21 +1485,56 @@ vector<Detection> DetectorYolov8::get_detections(float min_score, const Tensors&
             return {};
         }
 
-        // Create a detection for each box with max score above threshold
-        const float* data_pr = tensor.as_float();
+        // Create a detection for each box with max score above threshold.
+        // The anchors are processed in blocks, scanning the class rows sequentially.
+        // Only the boxes with some score above threshold are dequantized and decoded.
+        QuantizedScores qscores;
+        const bool quantized = qscores.init(tensor, min_score);
+        const float* data_pr = quantized ? nullptr : tensor.as_float();
+        if (!quantized && !data_pr) {
+            LOGE << "Failed to read tensor data";
+            return {};
+        }
         auto num_boxes = tensor.shape().at(2);
         LOGV << "Detector boxes: " << num_boxes;
+        float block_score[class_max_block];
+        int32_t block_class[class_max_block];
+        bool block_below[class_max_block];
         for (int32_t i = 0; i < num_boxes; i++) {
-            for (int32_t k = 0; k < raw_size; k++) {
-                detection_raw[k] = data_pr[num_boxes*k + i];
+            const size_t j = i % class_max_block;
+            if (j == 0) {
+                const size_t count = min<size_t>(class_max_block, num_boxes - i);
+                if (quantized) {
+                    qscores.all_below(num_boxes * classes_base_index + i, num_classes, num_boxes, count, block_below);
+                }
+                else {
+                    class_max(&data_pr[num_boxes * classes_base_index + i], num_classes, num_boxes, count,
+                              block_score, block_class);
+                }
+            }
+            int c;
+            float class_score;
+            if (quantized) {
+                if (block_below[j]) {
+                    continue;
+                }
+                tensor.as_float(detection_raw.data(), i, raw_size, num_boxes);
+                c = get_index_max(&detection_raw[classes_base_index], num_classes);
+                class_score = c == -1 ? 0 : detection_raw[classes_base_index + c];
+            }
+            else {
+                c = block_class[j];
+                class_score = block_score[j];
             }
-            const RawDetection* detection = reinterpret_cast<const RawDetection*>(detection_raw.data());
-            int c = get_index_max(detection->lm_class_confidence, num_classes);
-            if (c == -1) continue;
-
-            float class_score = detection->lm_class_confidence[c];
             // Overall confidence is too low
-            if (class_score < min_score) continue;
+            if (c == -1 || class_score < min_score) continue;
+
+            if (!quantized) {
+                for (int32_t k = 0; k < raw_size; k++) {
+                    detection_raw[k] = data_pr[num_boxes*k + i];
+                }
+            }
+            const RawDetection* detection = reinterpret_cast<const RawDetection*>(detection_raw.data());
             Box box;
             box.tl.x = (detection->x - detection->w / 2) * relative_scale.x;
             box.tl.y = (detection->y - detection->h / 2) * relative_scale.y;
@@ -952,21 +1622,57 @@ vector<Detection> DetectorYolov8Seg::get_detections(float min_score, const Tenso
     vector<float> detection_buf(detection_size);
     vector<Detection> dv;
 
-    const float* data_ptr = output_0.as_float();
+    // The anchors are processed in blocks, scanning the class rows sequentially.
+    // Only the boxes with some score above threshold are dequantized and decoded.
+    QuantizedScores qscores;
+    const bool quantized = qscores.init(output_0, min_score);
+    const float* data_ptr = quantized ? nullptr : output_0.as_float();
+    if (!quantized && !data_ptr) {
+        LOGE << "Failed to read tensor data";
+        return {};
+    }
     const int num_boxes = output_0_shape.at(2);
     LOGV << "Detector boxes: " << num_boxes;
 
+    float block_score[class_max_block];
+    int32_t block_class[class_max_block];
+    bool block_below[class_max_block];
     for (int i = 0; i < num_boxes; i++) {
-        for (int j = 0; j < detection_size; j++) {
-            detection_buf[j] = data_ptr[num_boxes*j + i];
+        const size_t b = i % class_max_block;
+        if (b == 0) {
+            const size_t count = min<size_t>(class_max_block, num_boxes - i);
+            if (quantized) {
+                qscores.all_below(num_boxes * bbox_data_len + i, num_classes, num_boxes, count, block_below);
+            }
+            else {
+                class_max(&data_ptr[num_boxes * bbox_data_len + i], num_classes, num_boxes, count,
+                          block_score, block_class);
+            }
+        }
+        int class_idx;
+        float class_score;
+        if (quantized) {
+            if (block_below[b]) {
+                continue;
+            }
+            output_0.as_float(detection_buf.data(), i, detection_size, num_boxes);
+            class_idx = get_index_max(&detection_buf[bbox_data_len], num_classes);
+            class_score = class_idx == -1 ? 0 : detection_buf[bbox_data_len + class_idx];
+        }
+        else {
+            class_idx = block_class[b];
+            class_score = block_score[b];
         }
-        const RawDetection* detection = reinterpret_cast<const RawDetection*>(detection_buf.data());
-        int class_idx = get_index_max(detection->sm_class_confidence, num_classes);
-        if (class_idx == -1) continue;
-        float class_score = detection->sm_class_confidence[class_idx];
         // Overall confidence is too low
-        if (class_score < min_score) continue;
-    
+        if (class_idx == -1 || class_score < min_score) continue;
+
+        if (!quantized) {
+            for (int j = 0; j < detection_size; j++) {
+                detection_buf[j] = data_ptr[num_boxes*j + i];
+            }
+        }
+        const RawDetection* detection = reinterpret_cast<const RawDetection*>(detection_buf.data());
+
         // bounding box
         Box box;
         box.tl.x = (detection->x - detection->w / 2) * relative_scale.x;
@@ -1125,31 +1831,48 @@ vector<Detection> DetectorYolov5Pyramid::get_detections(float min_score, const T
         int height = shape[_y_axis];
         int width = shape[_x_axis];
         int stripe = _ol == OutLayout::adhw? height * width : 1;
-        const float* out_data = tensor.as_float();
+        constexpr size_t confidence_index = offsetof(RawDetection, confidence) / sizeof(float);
+
+        // With quantized data only the detections with confidence above threshold are dequantized
+        QuantizedScores qscores;
+        const bool quantized = qscores.init(tensor, logit_min_score);
+        const float* out_data = quantized ? nullptr : tensor.as_float();
+        if (quantized) {
+            detection.resize(det_sz);
+        }
 
         for (int y = 0; y < height; y++) {
             for (int x = 0; x < width; x++) {
                 for (int a = 0; a < _anchors_count; a++) {
-                    const float* dptr{};
+                    size_t dindex{};
                     switch(_ol) {
                     case OutLayout::hwad:
-                        dptr = &out_data[((y * width + x) * _anchors_count + a) * det_sz];
+                        dindex = ((y * width + x) * _anchors_count + a) * det_sz;
                         break;
                     case OutLayout::ahwd:
-                        dptr = &out_data[((a * height + y) * width + x) * det_sz];
+                        dindex = ((a * height + y) * width + x) * det_sz;
                         break;
                     case OutLayout::adhw:
-                        dptr = &out_data[(a * det_sz * height + y) * width + x];
+                        dindex = (a * det_sz * height + y) * width + x;
                         break;
                     }
-                    float confidence = dptr[stripe * offsetof(RawDetection, confidence) / sizeof(float)];
+                    if (quantized) {
+                        if (qscores.below(dindex + stripe * confidence_index)) {
+                            // Overall confidence too low, just skip this detection.
+                            continue;
+                        }
+                        // Dequantize (and "de-stripe") the detection
+                        tensor.as_float(detection.data(), dindex, det_sz, stripe);
+                    }
+                    const float* dptr = quantized ? detection.data() : &out_data[dindex];
+                    float confidence = dptr[quantized ? confidence_index : stripe * confidence_index];
                     if (confidence < logit_min_score) {
                         // Overall confidence too low, just skip this detection.
                         continue;
                     }
 
                     auto d = reinterpret_cast<const RawDetection*>(dptr);
-                    if (stripe > 1) {
+                    if (stripe > 1 && !quantized) {
                         // "De-stripe" the detection
                         for (int i = 0; i < det_sz; i++) {
                             detection[i] = dptr[stripe * i];
@@ -1202,12 +1925,15 @@ vector<Detection> DetectorYolov5Pyramid::get_detections(float min_score, const T
 //
 
 
-Detector::Detector(float score_threshold, int n_max, bool nms, float iou_threshold, bool iou_with_min)
+Detector::Detector(float score_threshold, int n_max, bool nms, float iou_threshold, bool iou_with_min,
+                   bool nms_per_class, int pre_nms_top_k)
   : _score_threshold{score_threshold},
     _max_detections{n_max},
     _nms{nms},
     _iou_threshold{iou_threshold},
-    _iou_with_min{iou_with_min}
+    _iou_with_min{iou_with_min},
+    _nms_per_class{nms_per_class},
+    _pre_nms_top_k{pre_nms_top_k}
 {
 }
 
@@ -1217,6 +1943,13 @@ Detector::~Detector()
 }
 
 
+void Detector::set_mask_encoding(BinaryMask::Encoding encoding, float threshold)
+{
+    _mask_encoding = encoding;
+    _mask_threshold = threshold;
+}
+
+
 // Limit the given value to the range [lo, hi]
 static inline void clamp(Dim2d& val, const Dim2d& lo, const Dim2d& hi)
 {
@@ -1263,6 +1996,7 @@ bool Detector::init(const Tensors& tensors)
 
 Detector::Result Detector::process(const Tensors& tensors, const Rect& input_rect)
 {
+    TraceScope trace("detector", "postprocess");
     if (!d) {
         // Self-init detector if not yet done
         init(tensors);
@@ -1275,18 +2009,22 @@ Detector::Result Detector::process(const Tensors& tensors, const Rect& input_rec
     // Get detections and select them according to score and IoU
     Timer tmr;
     vector<Detection> dv = d->get_detections(_score_threshold, tensors, input_rect.size);
-    vector<int32_t> selected = select(_max_detections, dv, _nms, _iou_threshold, _iou_with_min);
-    uint32_t n_threads = d->n_threads();
+    const int32_t pre_nms_top_k = _pre_nms_top_k > 0 ? _pre_nms_top_k : d->pre_nms_top_k();
+    vector<int32_t> selected = select(_max_detections, dv, _nms, _iou_threshold, _iou_with_min, _nms_per_class,
+                                      pre_nms_top_k);
 
     // Create result with selected detections (ensure the bounding box is inside the image)
     Detector::Result res;
-#if SYNAP_NB_NEON
-    LOGV << "Neon intrinsics will be used for matmul";
-#endif
-    Timer::Duration mmul_dur = 0;
+    res.items.reserve(selected.size());
     bool is_chw = tensors[0].layout() == Layout::nchw;
     const float* output_1 = tensors.size() == 2 ? tensors[1].as_float() : nullptr;
     const Dim2d zero{0, 0};
+    const bool binary_masks = _mask_encoding != BinaryMask::Encoding::none;
+    vector<MaskJob> mask_jobs;
+    vector<size_t> mask_items;
+    vector<size_t> crop_offsets;
+    size_t crops_size = 0;
+    const MaskData* mask_info{};
     for (auto idx : selected) {
         const Detection& d = dv[idx];
         Detector::Result::Item item;
@@ -1309,17 +2047,67 @@ Detector::Result Detector::process(const Tensors& tensors, const Rect& input_rec
             }
         }
         
+        res.items.push_back(item);
+
         if (d.mask_data && output_1 != nullptr) {
-            auto t0 = tmr.get();
-            item.mask = compute_masks_parallel(d.mask_data, output_1, n_threads, is_chw);
-            auto t1 = tmr.get();
-            mmul_dur += t1 - t0;
-            if (item.mask.data() == nullptr) LOGE << "Invalid mask";
+            // Box in mask coordinates, pixel x is inside if x >= box.tl.x && x < box.br.x
+            const MaskData& md = d.mask_data;
+            const float sx = float(md.mask_width) / max(input_rect.size.x, 1);
+            const float sy = float(md.mask_height) / max(input_rect.size.y, 1);
+            const auto to_mask = [](float v, float scale, uint32_t size) {
+                return int32_t(min(max(ceil(v * scale), 0.0f), float(size)));
+            };
+            MaskJob job{md.mask_score_vec.data(),
+                        to_mask(d.box.tl.x, sx, md.mask_width), to_mask(d.box.tl.y, sy, md.mask_height),
+                        to_mask(d.box.br.x, sx, md.mask_width), to_mask(d.box.br.y, sy, md.mask_height)};
+            if (binary_masks) {
+                // The values inside the box are computed in a temporary buffer
+                job.stride = max(job.x1 - job.x0, 0);
+                crop_offsets.push_back(crops_size);
+                crops_size += job.stride * max(job.y1 - job.y0, 0);
+            }
+            else {
+                Mask& mask = res.items.back().mask;
+                mask = Mask{md.mask_width, md.mask_height};
+                if (mask.data() == nullptr) {
+                    LOGE << "Invalid mask";
+                    continue;
+                }
+                job.stride = md.mask_width;
+                job.data = mask.data() + job.y0 * job.stride + job.x0;
+            }
+            mask_jobs.push_back(job);
+            mask_items.push_back(res.items.size() - 1);
+            mask_info = &md;
+        }
+    }
+    if (!mask_jobs.empty()) {
+        auto t0 = tmr.get();
+        vector<float> crops(crops_size);
+        if (binary_masks) {
+            for (size_t i = 0; i < mask_jobs.size(); i++) {
+                mask_jobs[i].data = crops.data() + crop_offsets[i];
+            }
+        }
+        compute_masks(mask_jobs, output_1, mask_info->mask_features, mask_info->mask_height, mask_info->mask_width,
+                      is_chw, *this->d);
+        LOGV << "Total matmul time: " << tmr.get() - t0 << " us";
+
+        if (binary_masks) {
+            // Mask values are logits, convert the probability threshold
+            const float threshold = _mask_threshold <= 0 ? -numeric_limits<float>::infinity() :
+                                    _mask_threshold >= 1 ? numeric_limits<float>::infinity() :
+                                    log(_mask_threshold / (1 - _mask_threshold));
+            const Dim2d size{int32_t(mask_info->mask_width), int32_t(mask_info->mask_height)};
+            this->d->parallel_for(mask_jobs.size(), [&](size_t i) {
+                const MaskJob& job = mask_jobs[i];
+                const Rect rect{{job.x0, job.y0}, {job.x1 - job.x0, max(job.y1 - job.y0, 0)}};
+                res.items[mask_items[i]].binary_mask = BinaryMask(job.data, job.stride, threshold, size, rect,
+                                                                  input_rect, _mask_encoding);
+            });
         }
-        res.items.push_back(item);
     }
     res.success = true;
-    LOGV << "Total matmul time: " << mmul_dur << " us";
     LOGV << "Post-processing time: " << tmr;
     LOGV << "Objects detected: " << res.items.size();
     return res;
@@ -21,6 +21,7 @@ void to_json(json& j, const Dim2d& p);
 void to_json(json& j, const Landmark& p);
 void to_json(json& j, const Mask& p);
 void to_json(json& j, const Rect& p);
+void to_json(json& j, const BinaryMask& p);
 void to_json(json& j, const Detector::Result::Item& p);
 void to_json(json& j, const Detector::Result& p);
 void to_json(json& j, const Classifier::Result& p);
@@ -55,6 +56,25 @@ void to_json(json& j, const Rect& p)
 }
 
 
+void to_json(json& j, const BinaryMask& mask)
+{
+    static const char* encodings[] = {"none", "bits", "bytes", "rle"};
+    j = json{
+        {"encoding", encodings[static_cast<int>(mask.encoding())]},
+        {"width", mask.size().x},
+        {"height", mask.size().y},
+        {"rect", mask.rect()},
+        {"image_rect", mask.image_rect()}
+    };
+    if (mask.encoding() == BinaryMask::Encoding::rle) {
+        j["data"] = mask.runs();
+    }
+    else {
+        j["data"] = mask.data();
+    }
+}
+
+
 void to_json(json& j, const Detector::Result::Item& p)
 {
     json lms = json{ { "points", p.landmarks } };
@@ -65,6 +85,9 @@ void to_json(json& j, const Detector::Result::Item& p)
         {"landmarks", lms },
         {"mask", p.mask}
     };
+    if (p.binary_mask) {
+        j["binary_mask"] = p.binary_mask;
+    }
 }
 
 void to_json(json& j, const Detector::Result& p)
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -23,7 +24,9 @@ class Preprocessor {
 public:
     ///  Construct with default preprocessing options.
     /// There are no customizable preprocessing options at the moment
-    Preprocessor() {}
+    Preprocessor();
+
+    ~Preprocessor();
 
     /// Write InputData to tensor.
     /// Perform conversions to adapt the data to the tensor layout and format if possible.
@@ -35,6 +38,29 @@ public:
     /// - uv8: 8-bits uv interleaved components of yuv image
     /// - vu8: 8-bits vu interleaved components of yuv image
     ///
+    /// Images are resized to the tensor dimensions if needed. The resize algorithm can be
+    /// selected with the `resize` key in the tensor format:
+    /// - (default): high quality filtering, done in a temporary image before the conversion
+    /// - bilinear: faster bilinear interpolation
+    /// - nearest: nearest pixel, fastest but lowest quality
+    /// - area: average of the input pixels, good quality and fast for integer downscaling ratios
+    ///   (for example 1920x1080 to 640x360), bilinear interpolation is used for the other ratios
+    ///
+    /// Except for the default one, resize is done one row at a time together with the layout and
+    /// format conversion and the normalization, using SIMD instructions when available.
+    ///
+    /// nv12 and nv21 images are split in their y and uv/vu components if assigned to tensors with
+    /// 1 and 2 channels. If assigned to a tensor with 3 channels they are instead converted
+    /// to rgb or bgr and resized if needed, with bilinear interpolation unless a different
+    /// algorithm is selected in the tensor format. In this case the image size can be specified
+    /// in the InputData shape as [1, height, width, 1], if not specified it is assumed to be
+    /// the same as the tensor.
+    ///
+    /// The processing of 8-bits images is prepared the first time a given image shape and format
+    /// is assigned to a tensor and reused for the following images, so that assigning the frames
+    /// of a video stream doesn't require any format parsing or memory allocation.
+    /// This method can be called concurrently from multiple threads.
+    ///
     /// @param t: destination tensor
     /// @param data: input data to be assigned
     /// @param[out] assigned_rect: if not nullptr will contain the coordinates of the part of the
@@ -54,6 +80,38 @@ public:
     /// @return true if success
     bool assign(Tensors& ts, const InputData& data, size_t start_index = 0, Rect* assigned_rect = nullptr) const;
 
+    /// Write multiple regions of an image to the items of a tensor.
+    /// Typically used to prepare the input of a second-stage network with batch size > 1
+    /// from the detections of a first-stage network. Region i is cropped, resized, converted
+    /// and normalized directly into item i of the tensor, as done by assign() for an entire image.
+    /// The input can be an 8-bits nhwc image, an encoded image or a nv12/nv21 image
+    /// whose size is specified in the InputData shape as [1, height, width, 1].
+    /// The input rows are read or converted only once even if shared by multiple regions
+    /// and the regions are processed in parallel by a pool of worker threads.
+    /// Multiple calls on the same preprocessor are serialized.
+    ///
+    /// @param t: destination tensor, its batch size must be at least the number of regions
+    /// @param data: input image
+    /// @param rois: regions of the input image, clipped to the image if needed
+    /// @param[out] assigned_rects: if not nullptr will contain for each region the coordinates
+    /// of the part of the input image actually assigned, keeping into account the aspect ratio used
+    /// @return true if success
+    bool assign_rois(Tensor& t, const InputData& data, const std::vector<Rect>& rois,
+                     std::vector<Rect>* assigned_rects = nullptr) const;
+
+    /// Write multiple regions of an image to tensors.
+    /// Same as above, with region i assigned to tensor ts[i]. The tensors can belong to
+    /// different instances of the same network to run the second-stage inferences in parallel.
+    ///
+    /// @param ts: destination tensors, one for each region
+    /// @param data: input image
+    /// @param rois: regions of the input image, clipped to the image if needed
+    /// @param[out] assigned_rects: if not nullptr will contain for each region the coordinates
+    /// of the part of the input image actually assigned, keeping into account the aspect ratio used
+    /// @return true if success
+    bool assign_rois(const std::vector<Tensor*>& ts, const InputData& data, const std::vector<Rect>& rois,
+                     std::vector<Rect>* assigned_rects = nullptr) const;
+
     /// Set region of interest.
     /// The input images will be cropped to the specified rectangle if not empty.
     /// Note: requires the model to have been compiled with cropping enabled,
@@ -65,6 +123,10 @@ public:
 private:
     // Region of interest in the input image
     Rect _roi{};
+
+    // Preprocessing plans and worker threads
+    struct Private;
+    std::unique_ptr<Private> d;
 };
 
 
@@ -6,9 +6,18 @@
 #include "synap/image_utils.hpp"
 #include "synap/string_utils.hpp"
 #include "synap/image_convert.hpp"
+#include "synap/image_resize.hpp"
 #include "synap/logging.hpp"
 #include "synap/tensor.hpp"
+#include "synap/thread_pool.hpp"
 #include "synap/timer.hpp"
+#include "synap/trace.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
 
 
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
@@ -41,6 +50,769 @@ static int image_type_depth(ImageType image_type)
 }
 
 
+// Position of the resized input image inside the tensor
+struct ResizeGeometry {
+    // Number of input rows to be resized (the bottom of the image can be cut)
+    int32_t in_h;
+    // Size of the resized image
+    int32_t out_w;
+    int32_t out_h;
+    // Size of the fill bands above and on the left of the resized image
+    int32_t top;
+    int32_t left;
+};
+
+
+// Compute where the resized image has to be placed in the tensor, optionally preserving
+// input proportions, and update the assigned rectangle accordingly.
+static ResizeGeometry resize_geometry(const Dimensions& in_dim, const Dimensions& t_dim,
+                                      int keep_proportions, Rect* ar)
+{
+    ResizeGeometry g{in_dim.h, t_dim.w, t_dim.h, 0, 0};
+    if (keep_proportions) {
+        // Add a horizontal or vertical bar to avoid distorting the input image.
+        // The bars are added on both sides so that the rescaled image is always
+        // at the center of the tensor.
+        float in_ratio = (float)in_dim.w / in_dim.h;
+        g.out_h = t_dim.w / in_ratio + 0.5;
+        int band_height = t_dim.h - g.out_h;
+        if (band_height < 0) {
+            if (keep_proportions == 2) {
+                // Cut the bottom part of the image. This is faster than adding lateral bands
+                // if loosing bottom part of the image is not an issue.
+                g.out_h = t_dim.h;
+                band_height *= in_dim.w / t_dim.w;
+                g.in_h += band_height;
+                LOGW << "Proportional scaling is cutting the bottom " << - band_height << " image pixels";
+            }
+            else {
+                // Add vertical bars
+                // Use same h as the tensor and compute w to maintain aspect ratio
+                g.out_h = t_dim.h;
+                g.out_w = t_dim.h * in_ratio + 0.5;
+            }
+        }
+        else if (band_height > 0) {
+            g.top = band_height / 2;
+            LOGI << "Proportional scaling is filling horizontal bars of height "
+                 << g.top << "," << band_height - g.top << " tensor pixels";
+            ar->origin.y = -g.top * in_dim.w / t_dim.w;
+            ar->size.y += band_height * in_dim.w / t_dim.w;
+        }
+    }
+    if (g.out_w < t_dim.w) {
+        int band_width = t_dim.w - g.out_w;
+        g.left = band_width / 2;
+        LOGI << "Proportional scaling is filling vertical bars of width "
+             << g.left << "," << band_width - g.left << " tensor pixels";
+        ar->origin.x = -g.left * in_dim.h / t_dim.h;
+        ar->size.x += band_width * in_dim.h / t_dim.h;
+    }
+    return g;
+}
+
+
+// Get the row resize method with the given name (default: bilinear)
+static bool resize_method(const string& name, ImageRowResizer::Method* method)
+{
+    if (name.empty() || name == "bilinear") {
+        *method = ImageRowResizer::Method::bilinear;
+    }
+    else if (name == "nearest") {
+        *method = ImageRowResizer::Method::nearest;
+    }
+    else if (name == "area") {
+        *method = ImageRowResizer::Method::area;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+
+// Scratch memory with cache-line alignment
+class ScratchBuffer {
+public:
+    bool allocate(size_t size)
+    {
+        constexpr size_t alignment = 64;
+        _data.reset(static_cast<uint8_t*>(aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)));
+        return _data != nullptr || size == 0;
+    }
+
+    uint8_t* data() { return _data.get(); }
+
+private:
+    struct Free {
+        void operator()(uint8_t* p) const { free(p); }
+    };
+    unique_ptr<uint8_t, Free> _data;
+};
+
+
+// Everything that identifies the preprocessing of an image for a tensor
+struct PreprocessPlanKey {
+    InputType in_type;
+    Shape in_shape;
+    string in_format;
+    Shape t_shape;
+    Layout t_layout;
+    DataType t_type;
+    string t_format;
+    // Tensor data can be written directly (uint8 without normalization/quantization)
+    bool t_direct;
+    // Regions of the image are assigned to the tensor items instead of the entire image
+    bool crop;
+
+    bool matches(InputType in_typ, const Shape& in_shp, const string& in_fmt, const Tensor& t,
+                 bool t_dir, bool crp) const
+    {
+        return in_type == in_typ && in_shape == in_shp && in_format == in_fmt && t_shape == t.shape() &&
+               t_layout == t.layout() && t_type == t.data_type() && t_format == t.format() &&
+               t_direct == t_dir && crop == crp;
+    }
+};
+
+
+// Preprocessing plan to assign an 8-bits nhwc or a nv12/nv21 image to a tensor.
+// All the parameters and temporary buffers are computed once when the plan is created,
+// so assigning the frames of a video stream doesn't need any parsing or memory allocation.
+class PreprocessPlan {
+public:
+    // Resize with stb_image_resize or one row at a time with the image row resizer
+    enum class Resize { none, stb, rows };
+
+    // Create a plan, return nullptr if the image can't be assigned to the tensor
+    static unique_ptr<PreprocessPlan> create(const PreprocessPlanKey& key, const Tensor& t);
+
+    // Assign image to tensor
+    bool assign(Tensor& t, const uint8_t* in_data, size_t in_size, Rect* assigned_rect);
+
+    // Assign a region of an 8-bits image to an item of the tensor (crop plans only)
+    bool assign_crop(Tensor& t, size_t index, const uint8_t* in_data, size_t in_stride,
+                     const Rect& roi, Rect* assigned_rect);
+
+    const PreprocessPlanKey& key() const { return _key; }
+
+private:
+    PreprocessPlan(const PreprocessPlanKey& key) : _key{key} {}
+
+    // Resize directly in the tensor data (tensor has to be uint8 without normalization)
+    bool resize_to_tensor(uint8_t* outptr, const uint8_t* in_data, size_t in_stride, int32_t in_w,
+                          const ResizeGeometry& g);
+
+    // Resize, convert and normalize to the tensor item starting at t_offset one row at a time
+    bool assign_rows(Tensor& t, size_t t_offset, const uint8_t* in_data, size_t in_stride,
+                     int32_t in_w, Resize resize, const ResizeGeometry& g);
+
+    // Convert a row of a nv12/nv21 image to the tensor format
+    const uint8_t* yuv_row(const uint8_t* in_data, int32_t y, uint8_t* out_row);
+
+    const PreprocessPlanKey _key;
+    Dimensions _in_dim;
+    Dimensions _t_dim;
+    Resize _resize{};
+    ImageRowResizer::Method _method{};
+    int _keep_proportions{};
+    bool _direct{};
+    bool _swap{};
+    // Input is nv12/nv21 to be converted to rgb/bgr
+    bool _yuv{};
+    bool _bgr{};
+    int _fill_color{};
+    ResizeGeometry _geometry{};
+    Rect _assigned_rect{};
+
+    // Temporary buffers
+    ScratchBuffer _image;
+    ScratchBuffer _row;
+    ScratchBuffer _fill;
+    ScratchBuffer _planes;
+    ScratchBuffer _yuv_rgb;
+    ImageRowResizer _resizer;
+};
+
+
+unique_ptr<PreprocessPlan> PreprocessPlan::create(const PreprocessPlanKey& key, const Tensor& t)
+{
+    static constexpr char rgb[] = "rgb";
+    static constexpr char bgr[] = "bgr";
+    unique_ptr<PreprocessPlan> plan{new PreprocessPlan(key)};
+    PreprocessPlan& p = *plan;
+    const string t_fmt = format_parse::get_type(key.t_format);
+    const Dimensions& t_dim = p._t_dim = t.dimensions();
+    const int32_t c = t_dim.c;
+    p._in_dim = Dimensions(key.in_shape, Layout::nhwc);
+    p._yuv = key.in_type == InputType::nv12 || key.in_type == InputType::nv21;
+    if (p._yuv) {
+        // Image is converted to rgb or bgr, if image size not specified assume it is the same as the tensor
+        if (c != 3 || (t_fmt != rgb && t_fmt != bgr && t_fmt != "")) {
+            LOGE << "Unable to convert yuv image to tensor with " << c << " channels, format: " << t_fmt;
+            return nullptr;
+        }
+        p._in_dim = p._in_dim.empty() ? Dimensions{1, t_dim.h, t_dim.w, c} : Dimensions{1, p._in_dim.h, p._in_dim.w, c};
+        p._bgr = t_fmt == bgr;
+    }
+    const Dimensions& in_dim = p._in_dim;
+    if (in_dim.h <= 0 || in_dim.w <= 0) {
+        LOGE << "Invalid image dimensions: " << in_dim;
+        return nullptr;
+    }
+    p._assigned_rect = Rect{{0, 0}, {in_dim.w, in_dim.h}};
+    p._geometry = ResizeGeometry{in_dim.h, in_dim.w, in_dim.h, 0, 0};
+
+    if (key.crop || in_dim != t_dim) {
+        // For crop plans the resize parameters are prepared for all the crops, the geometry
+        // depends on the size of each crop
+        const int keep_proportions = format_parse::get_int(key.t_format, "keep_proportions", 1);
+        p._keep_proportions = keep_proportions;
+        p._fill_color = format_parse::get_int(key.t_format, "fill_color", 128);
+        const string resize = format_parse::get_string(key.t_format, "resize");
+        LOGI << "Resizing image from " << in_dim << " to " << t_dim
+             << " keep_proportions: " << keep_proportions << " fill_color: " << p._fill_color
+             << " resize: " << (resize.empty() ? "default" : resize);
+        if (resize.empty() && !p._yuv) {
+            p._resize = Resize::stb;
+        }
+        else if (resize_method(resize, &p._method)) {
+            // Yuv images are always converted and resized by rows
+            p._resize = Resize::rows;
+        }
+        else {
+            LOGE << "Unsupported resize algorithm: " << resize;
+            return nullptr;
+        }
+        if (in_dim.c != c || c < 1 || c > STBIR_MAX_CHANNELS) {
+            LOGE << "Unable to convert image from " << in_dim.c << " to " << c << " channels";
+            return nullptr;
+        }
+        // Write directly to the tensor only if it is uint8 without normalization/quantization
+        // and its format and layout match our input data
+        bool format_match = key.in_format == t_fmt || key.in_format.empty() || t_fmt.empty();
+        bool layout_match = key.t_layout == Layout::nhwc || key.t_layout == Layout::none;
+        p._direct = format_match && layout_match && key.t_direct && p._resize == Resize::stb && !p._yuv;
+        LOGV << "Direct write: " << p._direct << " (" << format_match << layout_match << key.t_direct << ")";
+
+        // Resize (optionally preserving input proportions)
+        if (!key.crop) {
+            p._geometry = resize_geometry(in_dim, t_dim, keep_proportions, &p._assigned_rect);
+        }
+    }
+    const ResizeGeometry& g = p._geometry;
+    if (p._direct) {
+        return plan;
+    }
+
+    if (key.t_layout != Layout::nhwc && key.t_layout != Layout::nchw) {
+        LOGE << "Layout mismatch. Data: " << Layout::nhwc << ", tensor: " << key.t_layout;
+        return nullptr;
+    }
+    if ((t_dim.n != 1 && !key.crop) || in_dim.c != c) {
+        LOGE << "Shape mismatch. Data: " << in_dim << ", tensor: " << t_dim;
+        return nullptr;
+    }
+    const string& in_format = key.in_format;
+    p._swap = c == 3 && !p._yuv && ((in_format == rgb && t_fmt == bgr) || (in_format == bgr && t_fmt == rgb));
+    if (!p._swap && !p._yuv && t_fmt != "" && in_format != "" && in_format != t_fmt) {
+        LOGE << "Format mismatch. Data: " << in_format << ", tensor: " << t_fmt;
+        return nullptr;
+    }
+
+    // Prepare temporary buffers. The parts of the tensor rows outside the image
+    // are filled once here since they never change.
+    const size_t row_size = t_dim.w * c;
+    const size_t out_row_size = g.out_w * c;
+    bool success = p._row.allocate(row_size) && p._fill.allocate(row_size);
+    if (p._resize == Resize::stb) {
+        // Crops are never resized to more than the tensor size
+        success &= p._image.allocate(key.crop ? row_size * t_dim.h : out_row_size * g.out_h);
+    }
+    if (key.t_layout == Layout::nchw) {
+        success &= p._planes.allocate(row_size);
+    }
+    if (p._yuv) {
+        success &= p._yuv_rgb.allocate(in_dim.w * c);
+    }
+    if (!success) {
+        LOGE << "Failed to allocate preprocessing buffers";
+        return nullptr;
+    }
+    memset(p._fill.data(), p._fill_color, row_size);
+    memset(p._row.data(), p._fill_color, row_size);
+    if (p._resize == Resize::rows && !key.crop &&
+        !p._resizer.init(in_dim.w, g.in_h, c, g.out_w, g.out_h, p._method)) {
+        return nullptr;
+    }
+    return plan;
+}
+
+
+bool PreprocessPlan::assign(Tensor& t, const uint8_t* in_data, size_t in_size, Rect* assigned_rect)
+{
+    const size_t expected_size = _yuv ? _in_dim.h * _in_dim.w + (_in_dim.h + 1) / 2 * ((_in_dim.w + 1) & ~1)
+                                      : size_t(_in_dim.h) * _in_dim.w * _in_dim.c;
+    if (in_size < expected_size) {
+        LOGE << "Input size mismatch, expected " << expected_size << ", got: " << in_size;
+        return false;
+    }
+    *assigned_rect = _assigned_rect;
+    const size_t in_stride = _in_dim.w * _in_dim.c;
+    uint8_t* outptr = _direct ? t.data<uint8_t>() : nullptr;
+    return outptr ? resize_to_tensor(outptr, in_data, in_stride, _in_dim.w, _geometry)
+                  : assign_rows(t, 0, in_data, in_stride, _in_dim.w, _resize, _geometry);
+}
+
+
+bool PreprocessPlan::assign_crop(Tensor& t, size_t index, const uint8_t* in_data, size_t in_stride,
+                                 const Rect& roi, Rect* assigned_rect)
+{
+    const int32_t c = _t_dim.c;
+    const Dimensions crop_dim{1, roi.size.y, roi.size.x, c};
+    const Dimensions item_dim{1, _t_dim.h, _t_dim.w, c};
+    const size_t item_size = size_t(item_dim.h) * item_dim.w * c;
+    const uint8_t* crop_data = in_data + roi.origin.y * in_stride + roi.origin.x * c;
+    Rect ar{{0, 0}, roi.size};
+    ResizeGeometry g{crop_dim.h, crop_dim.w, crop_dim.h, 0, 0};
+    const Resize resize = crop_dim != item_dim ? _resize : Resize::none;
+    if (resize != Resize::none) {
+        g = resize_geometry(crop_dim, item_dim, _keep_proportions, &ar);
+    }
+    *assigned_rect = Rect{{roi.origin.x + ar.origin.x, roi.origin.y + ar.origin.y}, ar.size};
+    if (!_direct) {
+        return assign_rows(t, index * item_size, crop_data, in_stride, crop_dim.w, resize, g);
+    }
+    uint8_t* outptr = t.data<uint8_t>() + index * item_size;
+    if (resize != Resize::none) {
+        return resize_to_tensor(outptr, crop_data, in_stride, crop_dim.w, g);
+    }
+    const size_t row_size = crop_dim.w * c;
+    for (int32_t y = 0; y < crop_dim.h; y++) {
+        memcpy(outptr + y * row_size, crop_data + y * in_stride, row_size);
+    }
+    return true;
+}
+
+
+bool PreprocessPlan::resize_to_tensor(uint8_t* outptr, const uint8_t* in_data, size_t in_stride,
+                                      int32_t in_w, const ResizeGeometry& g)
+{
+    const int32_t c = _t_dim.c;
+    const size_t t_row_size = _t_dim.w * c;
+    memset(&outptr[0], _fill_color, g.top * t_row_size);
+    memset(&outptr[(g.top + g.out_h) * t_row_size], _fill_color, (_t_dim.h - g.top - g.out_h) * t_row_size);
+    uint8_t* out_img_start = &outptr[g.out_w * g.top * c];
+    if (!stbir_resize_uint8(in_data, in_w, g.in_h, in_stride, out_img_start, g.out_w, g.out_h, 0, c)) {
+        LOGE << "Error resizing image";
+        return false;
+    }
+
+    if (g.out_w < _t_dim.w) {
+        auto band_width_left_c = g.left * c;
+        auto band_width_right_c = (_t_dim.w - g.out_w - g.left) * c;
+        auto out_w_c = g.out_w * c;
+
+        // Move each row of the rescaled image to make space for the vertical bar
+        auto lineptr_to = &outptr[t_row_size * (_t_dim.h - 1)];
+        auto lineptr_from = &outptr[out_w_c * (g.out_h - 1)];
+        while (lineptr_from >= outptr) {
+            // Use memmove instead of memcopy in case "to" and "from" overlap.
+            // The left bar is filled after the move since it can overlap the row to be moved.
+            memmove(lineptr_to + band_width_left_c, lineptr_from, out_w_c);
+            memset(lineptr_to, _fill_color, band_width_left_c);
+            memset(lineptr_to + band_width_left_c + out_w_c, _fill_color, band_width_right_c);
+            lineptr_from -= out_w_c;
+            lineptr_to -= t_row_size;
+        }
+    }
+#if SYNAP_DUMP_RESIZED_IMAGE
+    png_file_write(outptr, "resized.png", _t_dim.w, _t_dim.h, ImageType::rgb);
+#endif
+    // We resized directly to output tensor, nothing else to do
+    LOGI << "Image resized directly to output tensor";
+    return true;
+}
+
+
+const uint8_t* PreprocessPlan::yuv_row(const uint8_t* in_data, int32_t y, uint8_t* out_row)
+{
+    const int32_t w = _in_dim.w;
+    const uint8_t* uv_row = in_data + _in_dim.h * w + y / 2 * ((w + 1) & ~1);
+    image_convert_yuv420sp_row_to_rgb(in_data + y * w, uv_row, w, out_row,
+                                      _key.in_type == InputType::nv21, _bgr);
+    return out_row;
+}
+
+
+// Each tensor row is resized, converted to the tensor format and layout and normalized
+// before moving to the next one, so that the data remains in the cache during all the steps.
+// The default resize algorithm can't be computed by rows, in this case the input image
+// is first resized to a temporary buffer.
+bool PreprocessPlan::assign_rows(Tensor& t, size_t t_offset, const uint8_t* in_data, size_t in_stride,
+                                 int32_t in_w, Resize resize, const ResizeGeometry& g)
+{
+    Timer tmr;
+    const int32_t c = _t_dim.c;
+    const int32_t t_w = _t_dim.w;
+    const size_t out_row_size = g.out_w * c;
+    const uint8_t* image = in_data;
+    size_t image_stride = in_stride;
+    if (resize == Resize::stb) {
+        if (!stbir_resize_uint8(in_data, in_w, g.in_h, in_stride, _image.data(), g.out_w, g.out_h, 0, c)) {
+            LOGE << "Error resizing image";
+            return false;
+        }
+        image = _image.data();
+        image_stride = out_row_size;
+        LOGV << "Image resized in " << tmr;
+    }
+    else if (resize == Resize::rows) {
+        // Start a new image
+        if (!_resizer.init(in_w, g.in_h, c, g.out_w, g.out_h, _method)) {
+            return false;
+        }
+    }
+    // Yuv rows are converted only when needed by the resizer
+    const ImageRowResizer::RowSource yuv_source = [this, in_data](int32_t y) {
+        return yuv_row(in_data, y, _yuv_rgb.data());
+    };
+
+    // Rows are copied to the row buffer only if they need fill bands or the format conversion
+    const size_t row_size = t_w * c;
+    const bool has_bands = g.out_w < t_w;
+    uint8_t* row = _row.data();
+    uint8_t* row_image = row + g.left * c;
+    if (has_bands && _key.crop) {
+        // The position of the bands depends on the crop
+        memset(row, _fill_color, g.left * c);
+        memset(row_image + out_row_size, _fill_color, row_size - out_row_size - g.left * c);
+    }
+    for (int32_t y = 0; y < _t_dim.h; y++) {
+        const uint8_t* src;
+        const int32_t image_y = y - g.top;
+        if (image_y < 0 || image_y >= g.out_h) {
+            src = _fill.data();
+        }
+        else if (resize == Resize::rows) {
+            if (_yuv) {
+                _resizer.row(yuv_source, image_y, row_image);
+            }
+            else {
+                _resizer.row(in_data, in_stride, image_y, row_image);
+            }
+            src = row;
+        }
+        else if (_yuv) {
+            yuv_row(in_data, image_y, row_image);
+            src = row;
+        }
+        else if (has_bands) {
+            memcpy(row_image, image + image_y * image_stride, out_row_size);
+            src = row;
+        }
+        else {
+            src = image + image_y * image_stride;
+        }
+
+        if (_key.t_layout == Layout::nhwc) {
+            if (_swap) {
+                for (int32_t x = 0; x < t_w; x++) {
+                    const uint8_t r = src[3 * x];
+                    row[3 * x + 1] = src[3 * x + 1];
+                    row[3 * x] = src[3 * x + 2];
+                    row[3 * x + 2] = r;
+                }
+                src = row;
+            }
+            if (!t.assign(src, t_offset + y * row_size, row_size)) {
+                return false;
+            }
+        }
+        else {
+            // Convert to planar format, swapping the channels if needed
+            uint8_t* planes = _planes.data();
+            for (int32_t ch = 0; ch < c; ch++) {
+                const uint8_t* in = src + (_swap ? c - 1 - ch : ch);
+                uint8_t* out = &planes[ch * t_w];
+                for (int32_t x = 0; x < t_w; x++) {
+                    out[x] = in[x * c];
+                }
+            }
+            for (int32_t ch = 0; ch < c; ch++) {
+                if (!t.assign(&planes[ch * t_w], t_offset + (ch * _t_dim.h + y) * t_w, t_w)) {
+                    return false;
+                }
+            }
+        }
+    }
+    LOGV << "Image assigned by rows in " << tmr << " (swap: " << _swap << ", layout: " << _key.t_layout << ")";
+    return true;
+}
+
+
+// Preprocessing plans created so far and resources for the assignment of multiple regions
+struct Preprocessor::Private {
+    // Max number of plans to keep (crops processed in parallel use one plan each)
+    static constexpr size_t max_plans = 16;
+
+    // Get a plan for exclusive use, create it if needed
+    unique_ptr<PreprocessPlan> acquire(InputType in_type, const Shape& in_shape, const string& in_format,
+                                       const Tensor& t, bool t_direct, bool crop = false)
+    {
+        {
+            lock_guard<mutex> lock(_mutex);
+            for (auto it = _plans.rbegin(); it != _plans.rend(); ++it) {
+                if ((*it)->key().matches(in_type, in_shape, in_format, t, t_direct, crop)) {
+                    unique_ptr<PreprocessPlan> plan = std::move(*it);
+                    _plans.erase(std::next(it).base());
+                    return plan;
+                }
+            }
+        }
+        LOGV << "Creating preprocessing plan";
+        const PreprocessPlanKey key{in_type, in_shape, in_format, t.shape(), t.layout(),
+                                    t.data_type(), t.format(), t_direct, crop};
+        return PreprocessPlan::create(key, t);
+    }
+
+    // Give back a plan so that it can be reused, the most recently used plans are kept
+    void release(unique_ptr<PreprocessPlan> plan)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _plans.push_back(std::move(plan));
+        if (_plans.size() > max_plans) {
+            _plans.erase(_plans.begin());
+        }
+    }
+
+    // Execute job(i) for i in [0, count) on the worker threads and on the calling thread
+    bool parallel_for(size_t count, const function<bool(size_t)>& job)
+    {
+        if (!_workers) {
+            _workers.reset(new ThreadPool());
+        }
+        atomic<size_t> next{0};
+        atomic<bool> success{true};
+        const auto worker = [&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                if (!job(i)) {
+                    success = false;
+                }
+            }
+        };
+        const size_t job_count = min(count, _workers->size() + 1);
+        for (size_t j = 1; j < job_count; j++) {
+            _workers->post(worker);
+        }
+        worker();
+        _workers->wait();
+        return success;
+    }
+
+    // Convert to rgb the rows of a nv12/nv21 image covered by the regions, each row only once
+    const uint8_t* yuv_to_rgb(const uint8_t* in_data, int32_t w, int32_t h, bool vu, const vector<Rect>& rois)
+    {
+        const size_t frame_size = size_t(w) * h * 3;
+        if (frame_size > _frame_size) {
+            if (!_frame.allocate(frame_size)) {
+                LOGE << "Failed to allocate rgb image";
+                _frame_size = 0;
+                return nullptr;
+            }
+            _frame_size = frame_size;
+        }
+        // Convert the same range of columns for all the rows, starting on a chroma sample
+        int32_t x0 = w;
+        int32_t x1 = 0;
+        _rows.assign(h, 0);
+        for (const Rect& roi : rois) {
+            x0 = min(x0, roi.origin.x & ~1);
+            x1 = max(x1, roi.origin.x + roi.size.x);
+            fill(_rows.begin() + roi.origin.y, _rows.begin() + roi.origin.y + roi.size.y, 1);
+        }
+        _row_index.clear();
+        for (int32_t y = 0; y < h; y++) {
+            if (_rows[y]) {
+                _row_index.push_back(y);
+            }
+        }
+        constexpr size_t rows_per_job = 16;
+        const uint8_t* uv_data = in_data + size_t(w) * h;
+        const size_t uv_stride = (w + 1) & ~1;
+        uint8_t* rgb = _frame.data();
+        parallel_for((_row_index.size() + rows_per_job - 1) / rows_per_job, [&](size_t job) {
+            const size_t end = min(_row_index.size(), (job + 1) * rows_per_job);
+            for (size_t i = job * rows_per_job; i < end; i++) {
+                const size_t y = _row_index[i];
+                image_convert_yuv420sp_row_to_rgb(in_data + y * w + x0, uv_data + y / 2 * uv_stride + x0,
+                                                  x1 - x0, rgb + (y * w + x0) * 3, vu, false);
+            }
+            return true;
+        });
+        return rgb;
+    }
+
+    // Assign each region to the corresponding tensor, or to the corresponding item of ts[0] if batch
+    bool assign_rois(const vector<Tensor*>& ts, bool batch, const InputData& data, const vector<Rect>& rois,
+                     vector<Rect>* assigned_rects);
+
+private:
+    mutex _mutex;
+    vector<unique_ptr<PreprocessPlan>> _plans;
+
+    // Resources for the assignment of multiple regions, one assignment at a time
+    mutex _rois_mutex;
+    unique_ptr<ThreadPool> _workers;
+    ScratchBuffer _frame;
+    size_t _frame_size{};
+    vector<uint8_t> _rows;
+    vector<int32_t> _row_index;
+};
+
+
+bool Preprocessor::Private::assign_rois(const vector<Tensor*>& ts, bool batch, const InputData& data,
+                                        const vector<Rect>& rois, vector<Rect>* assigned_rects)
+{
+    TraceScope trace("preprocess", "preprocess_rois");
+    Timer tmr;
+    InputType in_type = data.type();
+    Dimensions in_dim = data.dimensions();
+    Shape in_shape = data.shape();
+    string in_format = data.format();
+    const uint8_t* in_data = static_cast<const uint8_t*>(data.data());
+    size_t in_size = data.size();
+    vector<uint8_t> decoded_data;
+    if (!in_data) {
+        LOGE << "Unable to write to tensor, no input data";
+        return false;
+    }
+    for (Tensor* t : ts) {
+        // Make sure the tensor data is allocated before the parallel assignment
+        if (!t || !t->data()) {
+            LOGE << "Unable to write to tensor, data buffer address not available";
+            return false;
+        }
+    }
+
+    // Decode image or check yuv image size
+    const bool yuv = in_type == InputType::nv12 || in_type == InputType::nv21;
+    if (in_type == InputType::encoded_image) {
+        ImageType img_type{};
+        in_shape = Shape{1, 0, 0, 0};
+        decoded_data = image_read(in_data, in_size, &in_shape[2], &in_shape[1], &img_type);
+        in_shape[3] = image_type_depth(img_type);
+        in_dim = Dimensions(in_shape, Layout::nhwc);
+        in_format = "rgb";
+        in_data = decoded_data.data();
+        LOGV << "Input image decoded " << tmr << ". Shape: " << in_shape;
+    }
+    else if (yuv) {
+        const size_t yuv_size = in_dim.h * in_dim.w + (in_dim.h + 1) / 2 * ((in_dim.w + 1) & ~1);
+        if (in_dim.h <= 0 || in_dim.w <= 0 || in_size < yuv_size) {
+            LOGE << "Invalid yuv image, shape: " << in_shape << " size: " << in_size;
+            return false;
+        }
+        in_dim.c = 3;
+    }
+    else if (in_type != InputType::image_8bits || data.layout() != Layout::nhwc) {
+        LOGE << "Unable to assign regions of input data of type: " << static_cast<int>(in_type);
+        return false;
+    }
+    if (in_dim.h <= 0 || in_dim.w <= 0 || in_dim.c <= 0) {
+        LOGE << "Invalid image dimensions: " << in_dim;
+        return false;
+    }
+    const size_t image_size = size_t(in_dim.h) * in_dim.w * in_dim.c;
+    if (in_type == InputType::image_8bits && in_size < image_size) {
+        LOGE << "Input size mismatch, expected " << image_size << ", got: " << in_size;
+        return false;
+    }
+
+    // Clip regions to the image
+    vector<Rect> crops(rois.size());
+    for (size_t i = 0; i < rois.size(); i++) {
+        const Rect& roi = rois[i];
+        const int32_t x0 = max(roi.origin.x, 0);
+        const int32_t y0 = max(roi.origin.y, 0);
+        const int32_t x1 = min(roi.origin.x + roi.size.x, in_dim.w);
+        const int32_t y1 = min(roi.origin.y + roi.size.y, in_dim.h);
+        if (x1 <= x0 || y1 <= y0) {
+            LOGE << "Region " << i << " outside the image: " << roi;
+            return false;
+        }
+        crops[i] = Rect{{x0, y0}, {x1 - x0, y1 - y0}};
+    }
+
+    lock_guard<mutex> lock(_rois_mutex);
+    if (yuv) {
+        // The rows shared by multiple regions are converted only once
+        in_data = yuv_to_rgb(in_data, in_dim.w, in_dim.h, in_type == InputType::nv21, crops);
+        if (!in_data) {
+            return false;
+        }
+        in_shape = Shape{1, in_dim.h, in_dim.w, 3};
+        in_format = "rgb";
+        LOGV << "Yuv image converted in " << tmr;
+    }
+    if (assigned_rects) {
+        assigned_rects->resize(rois.size());
+    }
+
+    // Crops are distributed to the worker threads, each one uses its own preprocessing plan
+    const size_t in_stride = in_dim.w * in_dim.c;
+    bool success = parallel_for(crops.size(), [&](size_t i) {
+        Tensor& t = *ts[batch ? 0 : i];
+        const bool t_direct = t.data<uint8_t>() != nullptr;
+        unique_ptr<PreprocessPlan> plan = acquire(InputType::image_8bits, in_shape, in_format, t, t_direct, true);
+        if (!plan) {
+            return false;
+        }
+        Rect ar;
+        bool assigned = plan->assign_crop(t, batch ? i : 0, in_data, in_stride, crops[i], &ar);
+        release(std::move(plan));
+        if (assigned_rects) {
+            (*assigned_rects)[i] = ar;
+        }
+        return assigned;
+    });
+    LOGV << rois.size() << " regions assigned in " << tmr;
+    return success;
+}
+
+
+Preprocessor::Preprocessor() : d{new Private}
+{
+}
+
+
+Preprocessor::~Preprocessor()
+{
+}
+
+
+bool Preprocessor::assign_rois(Tensor& t, const InputData& data, const vector<Rect>& rois,
+                               vector<Rect>* assigned_rects) const
+{
+    const Dimensions t_dim = t.dimensions();
+    if (rois.size() > size_t(t_dim.n)) {
+        LOGE << "Too many regions for tensor " << t.name() << ": " << rois.size() << ", batch size: " << t_dim.n;
+        return false;
+    }
+    return d->assign_rois({&t}, true, data, rois, assigned_rects);
+}
+
+
+bool Preprocessor::assign_rois(const vector<Tensor*>& ts, const InputData& data, const vector<Rect>& rois,
+                               vector<Rect>* assigned_rects) const
+{
+    if (ts.size() != rois.size()) {
+        LOGE << "Number of regions " << rois.size() << " doesn't match number of tensors " << ts.size();
+        return false;
+    }
+    return d->assign_rois(ts, false, data, rois, assigned_rects);
+}
+
+
 void Preprocessor::set_roi(const Rect& roi)
 {
     _roi = roi;
@@ -49,21 +821,23 @@ void Preprocessor::set_roi(const Rect& roi)
 
 bool Preprocessor::assign(Tensor& t, const InputData& data, Rect* assigned_rect) const
 {
+    TraceScope trace("preprocess", "preprocess");
     // Supported formats
     static constexpr char rgb[] = "rgb";
     static constexpr char bgr[] = "bgr";
 
-    const string t_fmt = format_parse::get_type(t.format());
+    string t_fmt;
     Dimensions t_dim = t.dimensions();
     size_t t_item_size = synap_type_size(t.data_type());
     Dimensions in_dim = data.dimensions();
     InputType in_type = data.type();
-    Shape in_shape = data.shape();
+    const Shape* in_shape = &data.shape();
+    Shape decoded_shape;
     Layout in_layout = data.layout();
     string in_format = data.format();
     const uint8_t* in_data = static_cast<const uint8_t*>(data.data());
     size_t in_size = data.size();
-    vector<uint8_t> decoded_data, resized_data, nchw_data, formatted_data;
+    vector<uint8_t> decoded_data, nchw_data, formatted_data;
     Rect dummy_rect;
     Rect* ar = assigned_rect? assigned_rect : &dummy_rect;
     ar->origin = Dim2d{0,0};
@@ -92,12 +866,17 @@ bool Preprocessor::assign(Tensor& t, const InputData& data, Rect* assigned_rect)
         nv_name = "nv21";
         uv_name = "vu8";
     case InputType::nv12:
-        // Image resize or conversion to RGB not yet supported with nv12/nv21 input.
-        // We only support splitting nv12/nv21 in its y and uv/vu components.
+        // nv12/nv21 input can be converted to rgb/bgr (with resize) or split in its
+        // y and uv/vu components (no resize).
         LOGV << "Preprocess " << nv_name << ": " << t_dim.n << ", " << t_dim.h << ", " << t_dim.w
              << ", " << t_dim.c;
+        if (t_dim.c == 3) {
+            // Convert to rgb/bgr with a preprocessing plan
+            break;
+        }
         ar->size.x = t_dim.w;
         ar->size.y = t_dim.h;
+        t_fmt = format_parse::get_type(t.format());
         if (t_dim.c == 1 && (t_fmt == "y8" || t_fmt == "")) {
             // Extract y component
             auto nv_size =  (t_dim.h * t_dim.w) * 3 / 2;
@@ -121,139 +900,43 @@ bool Preprocessor::assign(Tensor& t, const InputData& data, Rect* assigned_rect)
         return false;
     case InputType::encoded_image:
         // Convert image to RGB
-        in_shape = Shape{1, 0, 0, 0};
-        decoded_data = image_read(in_data, in_size, &in_shape[2], &in_shape[1], &img_type);
-        in_shape[3] = image_type_depth(img_type);
-        in_dim = Dimensions(in_shape, Layout::nhwc);
+        decoded_shape = Shape{1, 0, 0, 0};
+        decoded_data = image_read(in_data, in_size, &decoded_shape[2], &decoded_shape[1], &img_type);
+        decoded_shape[3] = image_type_depth(img_type);
+        in_shape = &decoded_shape;
+        in_dim = Dimensions(decoded_shape, Layout::nhwc);
         in_type = InputType::image_8bits;
         in_layout = Layout::nhwc;
         in_format = "rgb";
         in_data = decoded_data.data();
         in_size = decoded_data.size();
-        LOGV << "Input image decoded " << tmr << ". Shape: " << in_shape;
+        LOGV << "Input image decoded " << tmr << ". Shape: " << decoded_shape;
         break;
     default:
         // Not an encoded image
         break;
     }
 
-    // 2. Resize input image to tensor shape
+    // 2. Resize, convert and normalize 8-bits and yuv images with a preprocessing plan
     ar->size.x = in_dim.w;
     ar->size.y = in_dim.h;
+    // (batches of images are only assigned as they are, by the generic code below)
     bool is_image_8bits_nhwc = in_type == InputType::image_8bits && in_layout == Layout::nhwc;
-    if (is_image_8bits_nhwc && !in_dim.empty() && !t_dim.empty() && in_dim != t_dim) {
-        int keep_proportions = format_parse::get_int(t.format(), "keep_proportions", 1);
-        const int fill_color = format_parse::get_int(t.format(), "fill_color", 128);
-        LOGI << "Resizing image from " << in_dim << " to " << t_dim
-             << " keep_proportions: " << keep_proportions << " fill_color: " << fill_color;
-        if (in_dim.c != t_dim.c || t_dim.c < 1 || t_dim.c > STBIR_MAX_CHANNELS) {
-            LOGE << "Unable to convert image from " << in_dim.c << " to " << t_dim.c << " channels";
-            return false;
-        }
-        // Write directly to the tensor only if it is uint8 without normalization/quantization
-        // and its format and layout match our input data
-        uint8_t* outptr = t.data<uint8_t>();
-        bool format_match = in_format == t_fmt || in_format.empty() || t_fmt.empty();
-        bool layout_match = in_layout == t.layout() || in_layout == Layout::none || t.layout() == Layout::none;
-        bool write_to_tensor = format_match && layout_match && outptr;
-        LOGV << "Direct write: " << write_to_tensor << " (" << format_match << layout_match << !!outptr << ")";
-
-        if (!write_to_tensor) {
-            // Alloc temporary buffer to contain resized image
-            resized_data.resize(t.item_count());
-            outptr = resized_data.data();
-        }
-        // Resize (optionally preserving input proportions)
-        auto out_h = t_dim.h;
-        auto out_w = t_dim.w;
-        auto in_h = in_dim.h;
-        int band_height_top = 0;
-        if (keep_proportions) {
-            // Add a horizontal or vertical bar to avoid distorting the input image.
-            // The bar is added to the bottom or right respectively, so the rescaled image is always
-            // aligned to the top/left corner of the tensor. The advantage is that if we are doing
-            // object detection the coordinates of the detected bounding boxes don't have to be shifted.
-            // For classification keeping the image at the center would probably give better results.
-            float in_ratio = (float)in_dim.w / in_dim.h;
-            out_h = t_dim.w / in_ratio + 0.5;
-            int band_height = t_dim.h - out_h;
-            if (band_height < 0) {
-                if (keep_proportions == 2) {
-                    // Cut the bottom part of the image. This is faster than adding lateral bands
-                    // if loosing bottom part of the image is not an issue.
-                    out_h = t_dim.h;
-                    band_height *= in_dim.w / t_dim.w;
-                    in_h += band_height;
-                    LOGW << "Proportional scaling is cutting the bottom " << - band_height << " image pixels";
-                }
-                else {
-                    // Add vertical bars
-                    // Use same h as the tensor and compute w to maintain aspect ratio
-                    out_h = t_dim.h;
-                    out_w = t_dim.h * in_ratio + 0.5;
-                }
-            }
-            else if (band_height > 0) {
-                band_height_top = band_height / 2;
-                int band_height_bottom = band_height - band_height_top;
-                LOGI << "Proportional scaling is filling horizontal bars of height "
-                     << band_height_top << "," << band_height_bottom << " tensor pixels";
-                memset(&outptr[0], fill_color, band_height_top * t_dim.w * in_dim.c);
-                memset(&outptr[(band_height_top + out_h) * t_dim.w * in_dim.c], fill_color, band_height_bottom * t_dim.w * in_dim.c);
-                ar->origin.y = -band_height_top * in_dim.w / t_dim.w;
-                ar->size.y += band_height * in_dim.w / t_dim.w;
-            }
-        }
-        uint8_t* out_img_start = &outptr[out_w * band_height_top * in_dim.c];
-        if (!stbir_resize_uint8(in_data, in_dim.w , in_h, 0, out_img_start, out_w, out_h, 0, in_dim.c)) {
-            LOGE << "Error resizing image";
+    bool is_yuv = in_type == InputType::nv12 || in_type == InputType::nv21;
+    if (((is_image_8bits_nhwc && !in_dim.empty() && t_dim.n == 1) || is_yuv) && !t_dim.empty()) {
+        const bool t_direct = t.data<uint8_t>() != nullptr;
+        unique_ptr<PreprocessPlan> plan = d->acquire(in_type, *in_shape, in_format, t, t_direct);
+        if (!plan) {
             return false;
         }
-
-        if (out_w < t_dim.w) {
-            int band_width = t_dim.w - out_w;
-            int band_width_left = band_width / 2;
-            int band_width_right = band_width - band_width_left;
-            // Add vertical bars at the left and right
-            LOGI << "Proportional scaling is filling vertical bars of width "
-                 << band_width_left << "," << band_width_right << " tensor pixels";
-            auto band_width_left_c = band_width_left * in_dim.c;
-            auto band_width_right_c = band_width_right * in_dim.c;
-            auto out_w_c = out_w * in_dim.c;
-            auto t_dim_w_c = t_dim.w * in_dim.c;
-            ar->origin.x = -band_width_left * in_dim.h / t_dim.h;
-            ar->size.x += band_width * in_dim.h / t_dim.h;
-            
-            // Move each row of the rescaled image to make space for the vertical bar
-            auto lineptr_to = &outptr[t_dim_w_c * (t_dim.h - 1)];
-            auto lineptr_from = &outptr[out_w_c * (out_h - 1)];
-            while (lineptr_from >= outptr) {
-                // Use memmove instead of memcopy in case "to" and "from" overlap
-                memset(lineptr_to, fill_color, band_width_left_c);
-                memmove(lineptr_to + band_width_left_c, lineptr_from, out_w_c);
-                memset(lineptr_to + band_width_left_c + out_w_c, fill_color, band_width_right_c);
-                lineptr_from -= out_w_c;
-                lineptr_to -= t_dim_w_c;
-            }
-        }
-#if SYNAP_DUMP_RESIZED_IMAGE
-        png_file_write(outptr, "resized.png", t_dim.w, t_dim.h, ImageType::rgb);
-#endif
-        if (write_to_tensor) {
-            // We resized directly to output tensor, nothing else to do
-            LOGI << "Image resized directly to output tensor";
-            return true;
-        }
-
-        // Update info about image after resize
-        in_shape[1] = in_dim.h = t_dim.h;
-        in_shape[2] = in_dim.w = t_dim.w;
-        in_data = resized_data.data();
-        in_size = resized_data.size();
-        decoded_data.resize(0);
+        bool success = plan->assign(t, in_data, in_size, ar);
+        d->release(std::move(plan));
+        LOGV << "Preprocessing done in " << tmr;
+        return success;
     }
-    if (!in_shape.empty() && in_shape != t.shape() && in_dim != t_dim) {
-        LOGE << "Shape mismatch. Data: " << in_shape << ", tensor: " << t.shape();
+    t_fmt = format_parse::get_type(t.format());
+    if (!in_shape->empty() && *in_shape != t.shape() && in_dim != t_dim) {
+        LOGE << "Shape mismatch. Data: " << *in_shape << ", tensor: " << t.shape();
         return false;
     }
 
@@ -265,7 +948,7 @@ bool Preprocessor::assign(Tensor& t, const InputData& data, Rect* assigned_rect)
             bool convert_to_bgr = in_format == rgb && t_fmt == bgr;
             LOGV << "Preprocess: conversion from nhwc to nchw (to_bgr: " << convert_to_bgr << ")";
             nchw_data.resize(in_size);
-            if (!nhwc_to_nchw(in_shape, in_data, nchw_data.data(), convert_to_bgr)) {
+            if (!nhwc_to_nchw(*in_shape, in_data, nchw_data.data(), convert_to_bgr)) {
                 LOGE << "Data conversion to nchw failed";
                 return false;
             }
@@ -273,7 +956,6 @@ bool Preprocessor::assign(Tensor& t, const InputData& data, Rect* assigned_rect)
             in_layout = t.layout();
             in_format = convert_to_bgr? bgr : in_format;
             decoded_data.resize(0);
-            resized_data.resize(0);
         }
     }
     if (in_layout != Layout::none && in_layout != t.layout()) {
@@ -297,7 +979,6 @@ bool Preprocessor::assign(Tensor& t, const InputData& data, Rect* assigned_rect)
         in_data = formatted_data.data();
         in_format = bgr;
         decoded_data.resize(0);
-        resized_data.resize(0);
         nchw_data.resize(0);
     }
     if (t_fmt != "" && in_format != "" && in_format != t_fmt) {
@@ -331,8 +1012,13 @@ bool Preprocessor::assign(Tensor& t, const InputData& data, Rect* assigned_rect)
 bool Preprocessor::assign(Tensors& ts, const InputData& data, size_t start_index, Rect* assigned_rect) const
 {
     InputType in_type = data.type();
-    // For nv12 and nv21 the input image is split in 2 network tensors
-    size_t tensor_count = in_type ==  InputType::nv12 || in_type ==  InputType::nv21? 2 : 1;
+    // For nv12 and nv21 the input image is split in 2 network tensors,
+    // unless it is converted to rgb/bgr in a single tensor with 3 channels
+    size_t tensor_count = 1;
+    if ((in_type == InputType::nv12 || in_type == InputType::nv21) && start_index < ts.size() &&
+        ts[start_index].dimensions().c != 3) {
+        tensor_count = 2;
+    }
 
     // Assign tensor data
     size_t end_index = min(start_index + tensor_count, ts.size());
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include "synap/model_blob.hpp"
+
 #include <string>
 #include <vector>
 
@@ -33,7 +35,7 @@ public:
         std::string meta;
 
         // graph data and meta data in memory
-        std::vector<uint8_t> model_data;
+        ModelBlob::Ptr model_data;
         std::string meta_data;
     };
 
@@ -64,13 +66,18 @@ public:
 
     const std::vector<TensorInfo>& outputs() const;
 
+    /// Max number of subgraphs to be executed in parallel (0 if not specified in the bundle)
     int parallel_limit() const;
 
+    /// True if the bundle requests pipelined (streaming) execution
+    bool pipeline() const;
+
 protected:
     std::vector<SubGraphInfo> _graph_info;
     std::vector<TensorInfo> _inputs;
     std::vector<TensorInfo> _outputs;
     int _parallel_limit{};
+    bool _pipeline{};
 
 private:
     bool parse(const std::string& info);
@@ -27,10 +27,18 @@ public:
     ~BundleParserZip() {}
 
     ///  init with a buffer.
+    ///  Graph models are copied from the buffer, which can be deleted after this call.
     ///
     ///  @param data: buffer containing bundle information
     bool init(const void* data, const size_t size) override;
 
+    ///  init with a model blob.
+    ///  Graph models stored without compression refer directly to the blob data,
+    ///  compressed ones are extracted in parallel.
+    ///
+    ///  @param archive: blob containing the zipped bundle
+    bool init(const ModelBlob::Ptr& archive);
+
 };
 
 }  // namespace synap
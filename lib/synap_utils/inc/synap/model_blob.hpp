@@ -0,0 +1,96 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Read-only, reference-counted model data.
+///
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace synaptics {
+namespace synap {
+
+/// Read-only model data.
+/// The data can be a read-only memory mapping of a model file, a private copy, a reference
+/// to memory owned by someone else or a part of another blob. Blobs are always handled via
+/// shared pointers, the underlying memory is released when the last reference is dropped.
+/// This allows to pass model data from the file down to the predictors without copies.
+class ModelBlob {
+public:
+    typedef std::shared_ptr<const ModelBlob> Ptr;
+
+    /// Map a file in memory.
+    /// If the file can't be mapped its content is read in memory instead.
+    ///
+    /// @param file_name: file to map
+    /// @return blob pointer, nullptr if the file can't be read
+    static Ptr map_file(const std::string& file_name);
+
+    /// Create a blob containing a copy of the data.
+    static Ptr copy(const void* data, size_t size);
+
+    /// Create a blob taking ownership of the data.
+    static Ptr take(std::vector<uint8_t>&& data);
+
+    /// Create a blob referring to memory owned by the caller, without copy.
+    /// The caller must keep the memory valid as long as the blob is in use.
+    static Ptr wrap(const void* data, size_t size);
+
+    /// Create a blob referring to a part of an existing blob.
+    /// The parent blob is kept alive as long as this blob is in use.
+    static Ptr slice(const Ptr& parent, size_t offset, size_t size);
+
+    /// Get a blob whose data remains valid as long as it is referenced.
+    /// This is the blob itself unless it refers to memory owned by someone else, or its data
+    /// are not aligned as requested, in which case a copy is done.
+    ///
+    /// @param blob: blob to be made persistent
+    /// @param alignment: required alignment of the data (max alignof(std::max_align_t))
+    /// @return blob pointer
+    static Ptr persistent(const Ptr& blob, size_t alignment = 1);
+
+    ~ModelBlob();
+    ModelBlob(const ModelBlob&) = delete;
+    ModelBlob& operator=(const ModelBlob&) = delete;
+
+    /// @return pointer to the data
+    const uint8_t* data() const { return _data; }
+
+    /// @return size of the data in bytes
+    size_t size() const { return _size; }
+
+    /// @return true if the blob contains no data
+    bool empty() const { return _size == 0; }
+
+    /// @return true if the data memory is owned by the blob (directly or via its parent)
+    bool owned() const { return _owned; }
+
+    /// @return true if the data are memory-mapped from a file (directly or via its parent)
+    bool mapped() const { return _mapping || (_parent && _parent->mapped()); }
+
+private:
+    ModelBlob() = default;
+
+    const uint8_t* _data{};
+    size_t _size{};
+    bool _owned{};
+
+    // Private copy of the data if any
+    std::vector<uint8_t> _copy;
+
+    // Memory mapping if any
+    void* _mapping{};
+    size_t _mapping_size{};
+
+    // Blob containing our data if any
+    Ptr _parent;
+};
+
+}  // namespace synap
+}  // namespace synaptics
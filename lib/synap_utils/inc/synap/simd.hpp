@@ -0,0 +1,59 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Runtime selection of SIMD instruction sets.
+///
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+// x86 SIMD code is compiled with function target attributes and selected at runtime
+#define SYNAP_SIMD_X86 1
+#endif
+
+#if SYNAP_NB_NEON && defined(__aarch64__)
+// NEON is always available on aarch64
+#define SYNAP_SIMD_NEON 1
+#endif
+
+namespace synaptics {
+namespace synap {
+
+/// SIMD instruction sets
+enum class SimdLevel { none, sse41, avx2, neon };
+
+
+/// Get the best SIMD instruction set available on this CPU.
+/// SIMD code can be disabled by setting the environment variable SYNAP_NB_SIMD=none,
+/// this is useful to compare results and performance with the portable implementation.
+///
+/// @return SIMD level to be used
+inline SimdLevel simd_level()
+{
+    static const SimdLevel level = [] {
+        const char* env = getenv("SYNAP_NB_SIMD");
+        if (env && strcmp(env, "none") == 0) {
+            return SimdLevel::none;
+        }
+#if SYNAP_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::avx2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return SimdLevel::sse41;
+        }
+#elif SYNAP_SIMD_NEON
+        return SimdLevel::neon;
+#endif
+        return SimdLevel::none;
+    }();
+    return level;
+}
+
+}  // namespace synap
+}  // namespace synaptics
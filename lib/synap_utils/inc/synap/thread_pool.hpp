@@ -0,0 +1,62 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Persistent pool of worker threads.
+///
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace synaptics {
+namespace synap {
+
+/// Pool of worker threads executing jobs in FIFO order.
+/// Threads are created once and reused for all the jobs, this avoids the overhead of
+/// creating a new thread for each job in code executed at each inference.
+class ThreadPool {
+public:
+    typedef std::function<void()> Job;
+
+    /// Create thread pool.
+    ///
+    /// @param thread_count: number of worker threads (0: number of hardware threads)
+    explicit ThreadPool(size_t thread_count = 0);
+
+    /// Wait for all the queued jobs to complete and stop the worker threads.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @return number of worker threads
+    size_t size() const { return _threads.size(); }
+
+    /// Queue a job for execution.
+    /// The job will be executed by the first available worker thread.
+    void post(Job job);
+
+    /// Wait until all the jobs queued so far have been executed.
+    void wait();
+
+private:
+    void worker();
+
+    std::vector<std::thread> _threads;
+    std::deque<Job> _jobs;
+    std::mutex _mutex;
+    std::condition_variable _job_available;
+    std::condition_variable _jobs_done;
+    size_t _busy{};
+    bool _stop{};
+};
+
+}  // namespace synap
+}  // namespace synaptics
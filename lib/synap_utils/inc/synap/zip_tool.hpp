@@ -48,6 +48,24 @@ public:
     /// \sa Archive::size
     bool extract_archive(uint32_t index, uint8_t * archiveData);
 
+    /// Location of an archive inside a zip opened from memory
+    struct Entry {
+        const uint8_t* data; ///< Archive data as stored in the zip (compressed or not)
+        size_t stored_size; ///< Size of the stored data
+        size_t size; ///< Size of the archive once extracted
+        bool compressed; ///< True if data are deflated, false if stored as-is
+    };
+
+    /// Locate an archive in a zip opened from memory without extracting it.
+    /// Archives stored without compression can be used directly from the zip memory.
+    /// \retval false if not found or not in a supported format
+    bool find_entry(const std::string & name, Entry* entry) const;
+
+    /// Extract an archive located with find_entry().
+    /// Doesn't use the ZipTool state so multiple entries can be extracted in parallel.
+    /// \warning \param out must point to a memory area of at least Entry::size bytes
+    static bool extract_entry(const Entry& entry, uint8_t* out);
+
 private:
     struct Private;
     std::unique_ptr<Private> d;
@@ -30,7 +30,10 @@ using json = nlohmann::json;
 //       "model": "out_1.onnx",
 //       "meta": "out_0.json"
 //     }
-//   ]
+//   ],
+//   "parallel_limit": 2, --> optional, max number of subgraphs executed in parallel
+//   "pipeline": true     --> optional, execute the stages of a linear chain of subgraphs
+//                            on consecutive frames (outputs are delayed by n_stages - 1 frames)
 // }
 
 
@@ -94,6 +97,9 @@ bool BundleParser::parse(const std::string& info)
         if (j.contains("parallel_limit")) {
             j.at("parallel_limit").get_to(_parallel_limit);
         }
+        if (j.contains("pipeline")) {
+            j.at("pipeline").get_to(_pipeline);
+        }
     } catch (json::parse_error& e) {
         LOGE << " parse json failed : " << e.what();
         return false;
@@ -159,6 +165,11 @@ int BundleParser::parallel_limit() const
     return _parallel_limit;
 }
 
+bool BundleParser::pipeline() const
+{
+    return _pipeline;
+}
+
 
 }  // namespace synap
 }  // namespace synaptics
@@ -5,8 +5,12 @@
 #include "synap/file_utils.hpp"
 #include "synap/logging.hpp"
 #include "synap/bundle_parser_zip.hpp"
+#include "synap/thread_pool.hpp"
 #include "synap/zip_tool.hpp"
 
+#include <algorithm>
+#include <atomic>
+
 using namespace std;
 
 namespace synaptics {
@@ -14,9 +18,23 @@ namespace synap {
 
 
 bool BundleParserZip::init(const void* data, const size_t size)
+{
+    if (!init(ModelBlob::wrap(data, size))) {
+        return false;
+    }
+
+    // Model data may refer to the caller buffer, make them independent from it
+    for (auto& gi: _graph_info) {
+        gi.model_data = ModelBlob::persistent(gi.model_data);
+    }
+    return true;
+}
+
+
+bool BundleParserZip::init(const ModelBlob::Ptr& archive)
 {
     ZipTool ztool;
-    if (!ztool.open(data, size)) {
+    if (!archive || !ztool.open(archive->data(), archive->size())) {
         LOGE << "Failed to open zip archive";
         return false;
     }
@@ -27,6 +45,14 @@ bool BundleParserZip::init(const void* data, const size_t size)
         return false;
     }
 
+    // Compressed models to be extracted
+    struct Extraction {
+        ZipTool::Entry entry;
+        vector<uint8_t> data;
+        SubGraphInfo* graph;
+    };
+    vector<Extraction> extractions;
+
     for (auto& gi: _graph_info) {
         vector<uint8_t> meta_data = ztool.extract_archive(gi.meta);
         gi.meta_data = string(meta_data.begin(), meta_data.end());
@@ -35,14 +61,43 @@ bool BundleParserZip::init(const void* data, const size_t size)
             return false;
         }
 
-        gi.model_data = ztool.extract_archive(gi.model);
-        if (gi.model_data.empty()) {
+        ZipTool::Entry entry;
+        if (!ztool.find_entry(gi.model, &entry) || entry.size == 0) {
             LOGE << "Failed to extract model data for graph: " << gi.model;
             return false;
         }
+        if (entry.compressed) {
+            extractions.push_back({entry, {}, &gi});
+        }
+        else {
+            // No need to extract, just refer to the model inside the archive
+            gi.model_data = ModelBlob::slice(archive, entry.data - archive->data(), entry.size);
+        }
     }
 
-    return true;
+    if (extractions.empty()) {
+        return true;
+    }
+
+    // Inflate compressed models in parallel
+    atomic<bool> success{true};
+    {
+        ThreadPool workers(min<size_t>(extractions.size(), thread::hardware_concurrency()));
+        for (auto& ex: extractions) {
+            workers.post([&ex, &success] {
+                ex.data.resize(ex.entry.size);
+                if (!ZipTool::extract_entry(ex.entry, ex.data.data())) {
+                    LOGE << "Failed to extract model data for graph: " << ex.graph->model;
+                    success = false;
+                }
+            });
+        }
+    }
+    for (auto& ex: extractions) {
+        ex.graph->model_data = ModelBlob::take(std::move(ex.data));
+    }
+
+    return success;
 }
 
 
@@ -0,0 +1,121 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+#include "synap/model_blob.hpp"
+#include "synap/file_utils.hpp"
+#include "synap/logging.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace synaptics {
+namespace synap {
+
+
+ModelBlob::Ptr ModelBlob::map_file(const std::string& file_name)
+{
+    int fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOGE << "Error: can't open file: " << file_name;
+        return {};
+    }
+    struct stat st {};
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        // Not a regular file or mapping not supported, read it
+        LOGV << "Can't map file, reading it: " << file_name;
+        vector<uint8_t> content = binary_file_read(file_name);
+        return content.empty() ? Ptr{} : take(std::move(content));
+    }
+
+    // Model data are normally read once sequentially at load time
+    madvise(mapping, st.st_size, MADV_WILLNEED);
+
+    Ptr blob(new ModelBlob);
+    auto b = const_cast<ModelBlob*>(blob.get());
+    b->_mapping = mapping;
+    b->_mapping_size = st.st_size;
+    b->_data = static_cast<const uint8_t*>(mapping);
+    b->_size = st.st_size;
+    b->_owned = true;
+    return blob;
+}
+
+
+ModelBlob::Ptr ModelBlob::copy(const void* data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    return take(vector<uint8_t>(bytes, bytes + size));
+}
+
+
+ModelBlob::Ptr ModelBlob::take(std::vector<uint8_t>&& data)
+{
+    Ptr blob(new ModelBlob);
+    auto b = const_cast<ModelBlob*>(blob.get());
+    b->_copy = std::move(data);
+    b->_data = b->_copy.data();
+    b->_size = b->_copy.size();
+    b->_owned = true;
+    return blob;
+}
+
+
+ModelBlob::Ptr ModelBlob::wrap(const void* data, size_t size)
+{
+    Ptr blob(new ModelBlob);
+    auto b = const_cast<ModelBlob*>(blob.get());
+    b->_data = static_cast<const uint8_t*>(data);
+    b->_size = size;
+    return blob;
+}
+
+
+ModelBlob::Ptr ModelBlob::slice(const Ptr& parent, size_t offset, size_t size)
+{
+    if (!parent || offset > parent->size() || size > parent->size() - offset) {
+        LOGE << "Invalid blob slice, offset: " << offset << " size: " << size;
+        return {};
+    }
+    Ptr blob(new ModelBlob);
+    auto b = const_cast<ModelBlob*>(blob.get());
+    b->_data = parent->data() + offset;
+    b->_size = size;
+    b->_owned = parent->owned();
+    b->_parent = parent;
+    return blob;
+}
+
+
+ModelBlob::Ptr ModelBlob::persistent(const Ptr& blob, size_t alignment)
+{
+    if (!blob) {
+        return {};
+    }
+    if (blob->owned() && reinterpret_cast<uintptr_t>(blob->data()) % alignment == 0) {
+        return blob;
+    }
+    LOGV << "Copying model data, size: " << blob->size();
+    return copy(blob->data(), blob->size());
+}
+
+
+ModelBlob::~ModelBlob()
+{
+    if (_mapping) {
+        munmap(_mapping, _mapping_size);
+    }
+}
+
+
+}  // namespace synap
+}  // namespace synaptics
@@ -0,0 +1,80 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+#include "synap/thread_pool.hpp"
+
+using namespace std;
+
+namespace synaptics {
+namespace synap {
+
+
+ThreadPool::ThreadPool(size_t thread_count)
+{
+    if (thread_count == 0) {
+        thread_count = max(thread::hardware_concurrency(), 1u);
+    }
+    _threads.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++) {
+        _threads.emplace_back(&ThreadPool::worker, this);
+    }
+}
+
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        _stop = true;
+    }
+    _job_available.notify_all();
+    for (auto& t : _threads) {
+        t.join();
+    }
+}
+
+
+void ThreadPool::post(Job job)
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _job_available.notify_one();
+}
+
+
+void ThreadPool::wait()
+{
+    unique_lock<mutex> lock(_mutex);
+    _jobs_done.wait(lock, [this] { return _jobs.empty() && _busy == 0; });
+}
+
+
+void ThreadPool::worker()
+{
+    unique_lock<mutex> lock(_mutex);
+    while (true) {
+        _job_available.wait(lock, [this] { return _stop || !_jobs.empty(); });
+        if (_jobs.empty()) {
+            // Stop requested and no more pending jobs
+            break;
+        }
+        Job job = std::move(_jobs.front());
+        _jobs.pop_front();
+        _busy++;
+        lock.unlock();
+
+        job();
+
+        lock.lock();
+        _busy--;
+        if (_jobs.empty() && _busy == 0) {
+            _jobs_done.notify_all();
+        }
+    }
+}
+
+
+}  // namespace synap
+}  // namespace synaptics
@@ -11,6 +11,8 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <cstring>
+#include <unordered_map>
 
 using namespace std;
 
@@ -22,6 +24,19 @@ struct ZipTool::Private
     mz_zip_archive _zip{};
     vector<mz_zip_archive_file_stat> _archives{};
 
+    // Index of each archive in _archives by name
+    unordered_map<string, size_t> _index{};
+
+    // Zip data if opened from memory
+    const uint8_t* _mem{};
+    size_t _mem_size{};
+
+    const mz_zip_archive_file_stat* find(const string& name) const
+    {
+        auto it = _index.find(name);
+        return it == _index.end() ? nullptr : &_archives[it->second];
+    }
+
     bool init()
     {
         auto num_file = mz_zip_reader_get_num_files(&_zip);
@@ -38,6 +53,7 @@ struct ZipTool::Private
                 return false;
             }
             _archives.emplace_back(stat);
+            _index.emplace(stat.m_filename, _archives.size() - 1);
         }
         return true;
     }
@@ -79,6 +95,8 @@ bool ZipTool::open(const void *zipData, size_t zipDataSize)
         LOGE << "Failed to read ZIP data";
         return false;
     }
+    d->_mem = static_cast<const uint8_t*>(zipData);
+    d->_mem_size = zipDataSize;
     return d->init();
 }
 
@@ -113,13 +131,7 @@ std::vector<ZipTool::Archive> ZipTool::get_archive_list() const
 
 vector<uint8_t> ZipTool::extract_archive(const std::string & name)
 {
-    const mz_zip_archive_file_stat * found{};
-    for (const auto & arch : d->_archives) {
-        if (name == arch.m_filename) {
-            found = &arch;
-            break;
-        }
-    }
+    const mz_zip_archive_file_stat * found = d->find(name);
     if (!found) {
         LOGE << "Not found in archive: " << name;
         return vector<uint8_t>{};
@@ -157,5 +169,65 @@ bool ZipTool::extract_archive(uint32_t index, uint8_t * archiveData)
 }
 
 
+bool ZipTool::find_entry(const std::string & name, Entry* entry) const
+{
+    const mz_zip_archive_file_stat * found = d->find(name);
+    if (!found) {
+        LOGE << "Not found in archive: " << name;
+        return false;
+    }
+    if (!d->_mem) {
+        LOGE << "Zip not opened from memory";
+        return false;
+    }
+    if (found->m_is_encrypted || !found->m_is_supported || (found->m_method != 0 && found->m_method != MZ_DEFLATED)) {
+        LOGE << "Unsupported archive format: " << name;
+        return false;
+    }
+
+    // Actual data follow the local header, whose variable fields may differ from
+    // the ones in the central directory
+    constexpr size_t local_header_size = 30;
+    constexpr uint32_t local_header_signature = 0x04034b50;
+    const uint64_t header_ofs = found->m_local_header_ofs;
+    if (header_ofs + local_header_size > d->_mem_size) {
+        LOGE << "Invalid local header for archive: " << name;
+        return false;
+    }
+    const uint8_t* header = d->_mem + header_ofs;
+    auto read16 = [](const uint8_t* p) { return uint32_t(p[0]) | uint32_t(p[1]) << 8; };
+    if ((read16(header) | read16(header + 2) << 16) != local_header_signature) {
+        LOGE << "Invalid local header signature for archive: " << name;
+        return false;
+    }
+    const uint64_t data_ofs = header_ofs + local_header_size + read16(header + 26) + read16(header + 28);
+    if (data_ofs + found->m_comp_size > d->_mem_size) {
+        LOGE << "Truncated archive: " << name;
+        return false;
+    }
+
+    entry->data = d->_mem + data_ofs;
+    entry->stored_size = found->m_comp_size;
+    entry->size = found->m_uncomp_size;
+    entry->compressed = found->m_method != 0;
+    return true;
+}
+
+
+bool ZipTool::extract_entry(const Entry& entry, uint8_t* out)
+{
+    if (!entry.compressed) {
+        memcpy(out, entry.data, entry.size);
+        return true;
+    }
+    size_t size = tinfl_decompress_mem_to_mem(out, entry.size, entry.data, entry.stored_size, 0);
+    if (size != entry.size) {
+        LOGE << "Failed to inflate archive, size: " << entry.size;
+        return false;
+    }
+    return true;
+}
+
+
 }  // namespace synap
 }  // namespace synaptics
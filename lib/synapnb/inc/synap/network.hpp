@@ -6,7 +6,10 @@
 ///
 
 #pragma once
+#include "synap/network_statistics.hpp"
 #include "synap/tensor.hpp"
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 
@@ -17,6 +20,8 @@ class NetworkPrivate;
 
 /// Load and execute a neural network on the NPU accelerator.
 class Network {
+    friend class PredictorBundle;
+
     // Implementation details
     std::unique_ptr<NetworkPrivate> d;
 
@@ -53,6 +58,20 @@ public:
     bool load_model(const void* model_data, size_t model_size, const char* meta_data = nullptr);
 
 
+    /// Create a new instance of the model loaded in this network.
+    /// The new instance has its own input and output tensors and buffers and can run inferences
+    /// independently of (and concurrently with) this network, while the immutable parts of the
+    /// model (model data, metadata, parsed model, compiled modules...) are shared when supported
+    /// by the delegate. This is much faster and uses less memory than loading the model again.
+    /// In case another model was previously loaded in the destination network it is disposed.
+    /// Models loaded from memory with load_model(model_data, ...) can only be cloned if the
+    /// delegate supports sharing, since the model data are not retained after loading.
+    ///
+    /// @param network         network where to create the new instance
+    /// @return                true if success
+    bool clone(Network& network) const;
+
+
     /// Run inference.
     /// Input data to be processed are read from input tensor(s).
     /// Inference results are generated in output tensor(s).
@@ -61,6 +80,41 @@ public:
     bool predict();
 
 
+    /// Run inference asynchronously.
+    /// The inference is queued and executed in a worker thread owned by the network, so that
+    /// the caller can do other processing (for example preprocess the next frame or postprocess
+    /// the previous one) while the NPU is busy. Requests are executed in submission order.
+    /// Input and output tensors must not be accessed or modified until the inference has completed.
+    /// Calling predict() or load_model() implicitly waits for all pending requests to complete.
+    ///
+    /// @param on_complete     optional callback invoked from the worker thread when the inference
+    ///                        has completed, with the inference result as parameter.
+    ///                        The following requests are executed only after the callback returns.
+    ///                        The callback can call predict() and predict_async(), wait() returns
+    ///                        immediately, the callback must not call load_model() or destroy
+    ///                        the network. Exceptions thrown by the callback are logged and ignored.
+    /// @return                future that becomes ready when the inference has completed,
+    ///                        its value is true if success.
+    std::future<bool> predict_async(std::function<void(bool success)> on_complete = {});
+
+
+    /// Wait for completion of all the pending asynchronous inferences.
+    void wait();
+
+
+    /// Get runtime statistics.
+    /// Statistics are collected for all the inferences since the model was loaded or statistics
+    /// were last reset. Collection is always enabled, its overhead is negligible.
+    /// Can be called from any thread, also while an inference is in progress.
+    ///
+    /// @return inference counters, latency of each inference phase and buffer attach/detach counts
+    NetworkStatistics statistics() const;
+
+
+    /// Reset runtime statistics.
+    void reset_statistics();
+
+
     /// Collection of input tensors that can be accessed by index and iterated.
     Tensors inputs;
 
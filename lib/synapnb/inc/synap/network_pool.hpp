@@ -0,0 +1,126 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Synap pool of network instances.
+///
+
+#pragma once
+#include "synap/network.hpp"
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace synaptics {
+namespace synap {
+
+/// Execute inferences of the same model on multiple network instances in parallel.
+/// Each instance has its own input and output tensors and is served by its own worker thread.
+/// Instances are created by cloning the first one, so they share the model whenever supported
+/// by the delegate (see Network::clone()).
+/// Requests are executed by the first free instance, results are delivered in submission order.
+/// This allows to keep the accelerator busy while the inputs of the next requests are assigned
+/// and the outputs of the previous ones are processed.
+class NetworkPool {
+public:
+    /// Assign the input tensors for a request.
+    /// Called from a worker thread before the inference.
+    /// @return true if success, if false the inference is not performed and the request fails
+    typedef std::function<bool(Tensors& inputs)> AssignInputs;
+
+    /// Read the output tensors of a request.
+    /// Called from a worker thread after the inference, in submission order.
+    /// The output tensors are only valid for the duration of the call.
+    typedef std::function<void(bool success, Tensors& outputs)> ReadOutputs;
+
+    /// Pool statistics
+    struct Statistics {
+        /// Number of requests submitted
+        size_t submitted{};
+
+        /// Number of requests completed (including failed ones)
+        size_t completed{};
+
+        /// Number of requests failed
+        size_t failed{};
+
+        /// Number of requests waiting for a free instance
+        size_t queue_depth{};
+
+        /// Max number of requests waiting for a free instance
+        size_t max_queue_depth{};
+
+        /// For each instance, fraction of time spent processing requests in the range [0, 1]
+        std::vector<float> utilization;
+    };
+
+    NetworkPool();
+    NetworkPool(const NetworkPool& rhs) = delete;
+    NetworkPool& operator=(const NetworkPool& rhs) = delete;
+
+    /// Wait for all the pending requests to complete and release the instances.
+    ~NetworkPool();
+
+
+    /// Load model and create the instances.
+    /// In case another model was previously loaded it is disposed before loading the one specified.
+    ///
+    /// @param model_file      path to .synap model file (see Network::load_model())
+    /// @param meta_file       path to the model's metadata file for legacy .nb models
+    /// @param instances       number of network instances (0: number of hardware threads)
+    /// @return                true if success
+    bool load_model(const std::string& model_file, const std::string& meta_file = "",
+                    size_t instances = 0);
+
+
+    /// Load model and create the instances.
+    /// In case another model was previously loaded it is disposed before loading the one specified.
+    ///
+    /// @param model_data      model data (see Network::load_model())
+    /// @param model_size      model size in bytes
+    /// @param meta_data       model's metadata for legacy .nb models
+    /// @param instances       number of network instances (0: number of hardware threads)
+    /// @return                true if success
+    bool load_model(const void* model_data, size_t model_size, const char* meta_data = nullptr,
+                    size_t instances = 0);
+
+
+    /// @return number of network instances
+    size_t size() const;
+
+
+    /// Submit an inference request.
+    ///
+    /// @param assign_inputs   function to assign the input tensors
+    /// @param read_outputs    optional function to read the output tensors
+    /// @return                future that becomes ready when the request has completed,
+    ///                        its value is true if success.
+    std::future<bool> submit(AssignInputs assign_inputs, ReadOutputs read_outputs = {});
+
+
+    /// Wait for completion of all the pending requests.
+    void wait();
+
+
+    /// @return statistics since the model was loaded or statistics were last reset
+    Statistics statistics() const;
+
+
+    /// Reset statistics.
+    void reset_statistics();
+
+
+    // Implementation class
+    class Private;
+
+private:
+    // Implementation details
+    std::unique_ptr<Private> d;
+};
+
+
+}  // namespace synap
+}  // namespace synaptics
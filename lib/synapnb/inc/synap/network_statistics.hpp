@@ -0,0 +1,75 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Synap network runtime statistics.
+///
+
+#pragma once
+#include <cstdint>
+
+namespace synaptics {
+namespace synap {
+
+
+/// Latency statistics of a phase of the inference.
+/// All durations are in microseconds. Percentiles are estimated from a histogram with
+/// logarithmic buckets, so they are accurate within 25% (and never larger than max).
+struct LatencyStatistics {
+    /// Number of measurements
+    uint64_t count{};
+
+    /// Sum of all the measured durations
+    uint64_t total{};
+
+    /// Max measured duration
+    uint64_t max{};
+
+    /// Median duration
+    uint64_t p50{};
+
+    /// 90th percentile duration
+    uint64_t p90{};
+
+    /// 99th percentile duration
+    uint64_t p99{};
+
+    /// @return average duration
+    uint64_t mean() const { return count ? total / count : 0; }
+};
+
+
+/// Network runtime statistics.
+/// Latency statistics only include successful inferences.
+struct NetworkStatistics {
+    /// Number of inferences executed
+    uint64_t inferences{};
+
+    /// Number of inferences failed
+    uint64_t failures{};
+
+    /// Validation and assignment of the input and output buffers
+    LatencyStatistics buffer_validation;
+
+    /// Cache flush of the input buffers
+    LatencyStatistics cache_flush;
+
+    /// Actual inference done by the delegate
+    LatencyStatistics predict;
+
+    /// Cache invalidation of the output buffers
+    LatencyStatistics cache_invalidate;
+
+    /// Complete inference including all the above phases
+    LatencyStatistics total;
+
+    /// Number of buffers attached to the network
+    uint64_t buffer_attach{};
+
+    /// Number of buffers detached from the network
+    uint64_t buffer_detach{};
+};
+
+
+}  // namespace synap
+}  // namespace synaptics
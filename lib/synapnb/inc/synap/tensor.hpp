@@ -72,7 +72,7 @@ public:
     /// This is a free-format string whose meaning is application dependent, for example
     /// "rgb", "bgr".
     /// @return tensor format
-    std::string format() const;
+    const std::string& format() const;
 
     /// Get tensor data type.
     /// The integral types are used to represent quantized data. The details of the quantization
@@ -110,6 +110,16 @@ public:
     /// @copydoc Tensor::assign
     bool assign(const float* data, size_t count);
 
+    /// Normalize and copy data to a range of items in the tensor data buffer.
+    /// The data is normalized and converted as in `assign(const uint8_t*, size_t)`, the
+    /// normalization parameters are selected according to the position of each item in the tensor.
+    /// This allows to fill a tensor in several steps, for example one row at a time.
+    /// @param data: pointer to data to be copied
+    /// @param offset: index of the first tensor item to be written
+    /// @param count: number of data items to be copied
+    /// @return true if success
+    bool assign(const uint8_t* data, size_t offset, size_t count);
+
     /// Copy raw data to the tensor data buffer.
     /// The data is considered as raw data so no normalization or conversion is done whatever
     /// the actual data-type of the tensor. The data size must be equal to the `size()`
@@ -160,10 +170,35 @@ public:
     /// Please note that this is a pointer to floating point data inside the tensor itself:
     /// this means that the returned pointer must *not* be freed, memory will be released
     /// automatically when the tensor is destroyed.
+    /// The conversion is done only when the tensor content has changed since the previous call
+    /// (because of an inference, an assignment or a change of buffer), so calling this method
+    /// multiple times is cheap.
     /// @return pointer to float[item_count()] array representing tensor content converted to float
     ///         (nullptr if tensor has no data)
     const float* as_float() const;
 
+    /// Convert a range of the tensor content to float.
+    /// Only the requested items are converted, this is useful when only a small part
+    /// of a large tensor is actually needed.
+    /// @param dst: pointer to float[count] array where the converted items are stored
+    /// @param offset: index of the first item to convert
+    /// @param count: number of items to convert
+    /// @param stride: distance between the items to convert, for example to convert a column
+    ///                of a row-major matrix
+    /// @return true if success, false if tensor has no data or range out of bounds
+    bool as_float(float* dst, size_t offset, size_t count, size_t stride = 1) const;
+
+    /// Convert a threshold to the quantized domain of the tensor.
+    /// This allows to compare the raw tensor data with a threshold without converting them to
+    /// float: for each raw item q, q >= quantized threshold if and only if the float value of q
+    /// is >= threshold. Only supported for 8-bits integer tensors whose conversion to float is
+    /// strictly increasing, for example affine quantization with a positive scale.
+    /// @param threshold: threshold in the float domain
+    /// @param[out] quantized: threshold in the quantized domain, this is one more than the max
+    ///                        representable value if no item can reach the threshold
+    /// @return true if success, false if not supported for this tensor
+    bool quantized_threshold(float threshold, int32_t* quantized) const;
+
     /// Get pointer to the tensor's current data Buffer if any.
     /// This will be the default buffer of the tensor unless the user has assigned a different
     /// buffer using set_buffer()
@@ -185,6 +220,8 @@ public:
 private:
     // Private implementation details
     void add_sibling(Tensor* t);
+    void invalidate();
+    friend class NetworkPrivate;
     friend class PredictorBundle;
     struct Private;
     std::unique_ptr<Private> d;
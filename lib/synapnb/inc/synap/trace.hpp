@@ -0,0 +1,103 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Synap execution tracing.
+///
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace synaptics {
+namespace synap {
+
+
+/// Record execution trace events and export them in Chrome trace-event JSON format.
+/// The resulting file can be visualized with chrome://tracing or https://ui.perfetto.dev to see
+/// the timeline of preprocessing, inference (including bundle subgraphs and their threads)
+/// and postprocessing.
+///
+/// Tracing is disabled by default, when disabled the overhead is a single atomic load.
+/// Events are kept in an in-memory ring buffer, when full the oldest events are overwritten.
+/// Tracing can be enabled programmatically or by setting the environment variable
+/// SYNAP_NB_TRACE to the name of the file where the trace will be saved at program exit.
+/// The size of the ring buffer can be specified with SYNAP_NB_TRACE_EVENTS.
+class Trace {
+public:
+    /// Default max number of events kept in the ring buffer
+    static constexpr size_t default_capacity = 65536;
+
+    /// Enable event recording. Previously recorded events are discarded.
+    ///
+    /// @param capacity: max number of events kept
+    static void enable(size_t capacity = default_capacity);
+
+    /// Disable event recording. Events recorded so far are kept.
+    static void disable();
+
+    /// @return true if event recording is enabled
+    static bool enabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    /// Record an event.
+    ///
+    /// @param name: event name, must be a string with static lifetime (e.g. a literal)
+    /// @param category: event category, must be a string with static lifetime
+    /// @param begin: begin time in microseconds (from Trace::now())
+    /// @param end: end time in microseconds (from Trace::now())
+    /// @param arg: optional event argument (e.g. index), not recorded if negative
+    static void record(const char* name, const char* category, int64_t begin, int64_t end,
+                       int64_t arg = -1);
+
+    /// @return current time in microseconds
+    static int64_t now();
+
+    /// @return recorded events in Chrome trace-event JSON format
+    static std::string to_json();
+
+    /// Save recorded events in Chrome trace-event JSON format.
+    ///
+    /// @param file_name: output file name
+    /// @return true if success
+    static bool save(const std::string& file_name);
+
+private:
+    static std::atomic<bool> _enabled;
+};
+
+
+/// Trace the execution of a scope.
+/// Records an event starting when the object is created and ending when it is destroyed.
+class TraceScope {
+public:
+    /// @param name: event name, must be a string with static lifetime (e.g. a literal)
+    /// @param category: event category, must be a string with static lifetime
+    /// @param arg: optional event argument (e.g. index), not recorded if negative
+    TraceScope(const char* name, const char* category, int64_t arg = -1) :
+        _name{Trace::enabled() ? name : nullptr}, _category{category}, _arg{arg},
+        _begin{_name ? Trace::now() : 0}
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (_name) {
+            Trace::record(_name, _category, _begin, Trace::now(), _arg);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* _name;
+    const char* _category;
+    int64_t _arg;
+    int64_t _begin;
+};
+
+
+}  // namespace synap
+}  // namespace synaptics
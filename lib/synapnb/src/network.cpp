@@ -9,7 +9,9 @@
 #include "synap/file_utils.hpp"
 #include "synap/string_utils.hpp"
 #include "synap/logging.hpp"
+#include "synap/model_blob.hpp"
 #include "synap/timer.hpp"
+#include "synap/trace.hpp"
 
 #include "buffer_private.hpp"
 #include "network_private.hpp"
@@ -62,9 +64,9 @@ bool NetworkPrivate::load_model_file(const std::string& model_file, const std::s
         return false;
     }
 
-    vector<uint8_t> model_data = binary_file_read(model_file);
-
-    if (model_data.empty()) {
+    // Map the model file in memory, predictors keep a reference to it only if needed
+    ModelBlob::Ptr model_data = ModelBlob::map_file(model_file);
+    if (!model_data || model_data->empty()) {
         LOGE << "Failed to load model: " << model_file;
         return false;
     }
@@ -79,7 +81,7 @@ bool NetworkPrivate::load_model_file(const std::string& model_file, const std::s
         model_meta_data_ptr = model_meta_data.c_str();
     }
 
-    return load_model_data(model_data.data(), model_data.size(), model_meta_data_ptr);
+    return load_model_blob(model_data, model_meta_data_ptr);
 }
 
 
@@ -117,18 +119,45 @@ static unique_ptr<Predictor> make_predictor(const string& delegate)
 
 bool NetworkPrivate::load_model_data(const void* data, size_t data_size, const char* meta_data)
 {
+    if (!data && data_size) {
+        LOGE << "Null model_data pointer";
+        return false;
+    }
+    // Model data belong to the caller, predictors will copy them if needed
+    return load_model_blob(data ? ModelBlob::wrap(data, data_size) : nullptr, meta_data);
+}
+
+
+void NetworkPrivate::unload()
+{
+    // Be sure the current model is not in use
+    wait_async();
+
     // Remove current predictor instance if any
     unregister_buffers();
+    _inputs.clear();
+    _outputs.clear();
     _predictor.reset();
+    _model.reset();
+    _reloadable = false;
+    _load_meta.reset();
+    _meta.reset();
+    _statistics.reset();
+}
+
+
+bool NetworkPrivate::load_model_blob(const ModelBlob::Ptr& model, const char* meta_data)
+{
+    unload();
 
     // If no metafile given use a Bundle predictor by default
     NetworkMetadata meta;
     meta.delegate = "bundle";
     Timer tmr;
 
-    if (!data) {
+    if (!model) {
         // Try to get delegate string directly from meta_data
-        if (data_size || format_parse::get_type(meta_data) != "bundle") {
+        if (!meta_data || format_parse::get_type(meta_data) != "bundle") {
             LOGE << "Null model_data pointer";
             return false;
         }
@@ -151,7 +180,8 @@ bool NetworkPrivate::load_model_data(const void* data, size_t data_size, const c
     }
 
     // Load model and check/update meta info
-    if (!_predictor->load_model(data, data_size, &meta)) {
+    auto load_meta = make_shared<const NetworkMetadata>(meta);
+    if (!_predictor->load_model(model, &meta)) {
         LOGE << "Failed to load model";
         _predictor = nullptr;
         return false;
@@ -161,9 +191,58 @@ bool NetworkPrivate::load_model_data(const void* data, size_t data_size, const c
     LOGI << "Network inputs: " << meta.inputs.size();
     LOGI << "Network outputs: " << meta.outputs.size();
 
+    _model = model && model->owned() ? model : nullptr;
+    _reloadable = !model || model->owned();
+    _load_meta = load_meta;
+    _meta = make_shared<const NetworkMetadata>(std::move(meta));
+
     // Create input and output tensors
-    _inputs = create_tensors(Tensor::Type::in, meta.inputs);
-    _outputs = create_tensors(Tensor::Type::out, meta.outputs);
+    _inputs = create_tensors(Tensor::Type::in, _meta->inputs);
+    _outputs = create_tensors(Tensor::Type::out, _meta->outputs);
+
+    return true;
+}
+
+
+bool NetworkPrivate::clone(NetworkPrivate& np) const
+{
+    if (&np == this) {
+        LOGE << "Can't clone a network into itself";
+        return false;
+    }
+    if (!_predictor) {
+        LOGE << "Network not loaded";
+        return false;
+    }
+    np.unload();
+    Timer tmr;
+
+    // Create a new predictor sharing the model with ours if possible
+    np._predictor = _predictor->clone();
+    if (!np._predictor) {
+        // Not supported by the delegate, load the model again from its data
+        if (!_reloadable) {
+            LOGE << "Model data not available to clone network, model must be loaded from file";
+            return false;
+        }
+        NetworkMetadata meta = *_load_meta;
+        np._predictor = make_predictor(format_parse::get_type(meta.delegate));
+        if (!np._predictor || !np._predictor->load_model(_model, &meta)) {
+            LOGE << "Failed to load model for cloned network";
+            np._predictor = nullptr;
+            return false;
+        }
+    }
+    LOGI << "Cloned Network (" << _meta->delegate << "): "  << tmr;
+
+    np._model = _model;
+    np._reloadable = _reloadable;
+    np._load_meta = _load_meta;
+    np._meta = _meta;
+
+    // Each clone has its own tensors and buffers
+    np._inputs = np.create_tensors(Tensor::Type::in, _meta->inputs);
+    np._outputs = np.create_tensors(Tensor::Type::out, _meta->outputs);
 
     return true;
 }
@@ -189,11 +268,25 @@ vector<Tensor> NetworkPrivate::create_tensors(Tensor::Type ttype, const vector<T
 
 
 bool NetworkPrivate::do_predict()
+{
+    // predict() may be called while the worker thread is starting a queued request
+    lock_guard<mutex> lock(_predict_mutex);
+    TraceScope trace("predict", "network");
+    NetworkStatisticsCollector::PhaseDurations durations{};
+    Timer tmr;
+    bool success = run_inference(durations);
+    _statistics.record_inference(durations, tmr.get(), success);
+    return success;
+}
+
+
+bool NetworkPrivate::run_inference(NetworkStatisticsCollector::PhaseDurations& durations)
 {
     if (!_predictor) {
         LOGE << "Network not correctly initialized";
         return false;
     }
+    Timer phase_tmr;
 
     // Check that input buffers have been assigned
     for (auto& in_tensor : _inputs) {
@@ -213,19 +306,28 @@ bool NetworkPrivate::do_predict()
             return false;
         }
     }
+    durations[NetworkStatisticsCollector::buffer_validation] = phase_tmr.get();
 
     LOGI << "Start inference";
     Timer tmr;
 
     // Flush cache for inputs
+    phase_tmr.start();
     for (auto& t : _inputs) {
         if (!t.buffer()->priv()->cache_flush()) {
             LOGE << "Cache flush failed for input: " << t.name();
             return false;
         }
     }
+    durations[NetworkStatisticsCollector::cache_flush] = phase_tmr.get();
 
-    bool success = _predictor->predict();
+    phase_tmr.start();
+    bool success;
+    {
+        TraceScope trace("delegate_predict", "delegate");
+        success = _predictor->predict();
+    }
+    durations[NetworkStatisticsCollector::predict] = phase_tmr.get();
     LOGI << "Inference time: " << tmr;
     if (!success) {
         LOGE << "Inference failed";
@@ -233,17 +335,93 @@ bool NetworkPrivate::do_predict()
     }
 
     // Invalidate cache for outputs
+    phase_tmr.start();
     for (auto& t : _outputs) {
         if (!t.buffer()->priv()->cache_invalidate()) {
             LOGE << "Cache invalidate failed for output: " << t.name();
             return false;
         }
+        t.invalidate();
     }
+    durations[NetworkStatisticsCollector::cache_invalidate] = phase_tmr.get();
 
     return true;
 }
 
 
+std::future<bool> NetworkPrivate::predict_async(std::function<void(bool)> on_complete)
+{
+    lock_guard<mutex> lock(_async_mutex);
+    if (!_async_thread.joinable()) {
+        _async_thread = thread(&NetworkPrivate::async_worker, this);
+    }
+    _async_queue.push_back({promise<bool>(), std::move(on_complete)});
+    future<bool> result = _async_queue.back().result.get_future();
+    _async_cv.notify_one();
+    return result;
+}
+
+
+void NetworkPrivate::wait_async()
+{
+    unique_lock<mutex> lock(_async_mutex);
+    if (this_thread::get_id() == _async_thread.get_id()) {
+        // Called from a completion callback: the current request has been executed and
+        // the following ones can only start when the callback returns
+        return;
+    }
+    _async_done.wait(lock, [this] { return _async_queue.empty() && !_async_busy; });
+}
+
+
+void NetworkPrivate::async_worker()
+{
+    unique_lock<mutex> lock(_async_mutex);
+    while (true) {
+        _async_cv.wait(lock, [this] { return _async_stop || !_async_queue.empty(); });
+        if (_async_queue.empty()) {
+            // Stop requested and no more pending requests
+            break;
+        }
+        AsyncRequest request = std::move(_async_queue.front());
+        _async_queue.pop_front();
+        _async_busy = true;
+        lock.unlock();
+
+        bool success = do_predict();
+        if (request.on_complete) {
+            try {
+                request.on_complete(success);
+            }
+            catch (const exception& e) {
+                LOGE << "Exception in predict_async callback: " << e.what();
+            }
+            catch (...) {
+                LOGE << "Exception in predict_async callback";
+            }
+        }
+        request.result.set_value(success);
+
+        lock.lock();
+        _async_busy = false;
+        _async_done.notify_all();
+    }
+}
+
+
+NetworkPrivate::~NetworkPrivate()
+{
+    {
+        lock_guard<mutex> lock(_async_mutex);
+        _async_stop = true;
+        _async_cv.notify_one();
+    }
+    if (_async_thread.joinable()) {
+        _async_thread.join();
+    }
+}
+
+
 bool NetworkPrivate::register_buffer(Buffer* buffer, size_t index, bool is_input)
 {
     BufferAttachment handle = buffer->priv()->handle(this);
@@ -254,6 +432,7 @@ bool NetworkPrivate::register_buffer(Buffer* buffer, size_t index, bool is_input
             return false;
         }
         LOGV << "Created buffer handle for " << buffer << " : " << handle;
+        _statistics.record_buffer_attach();
 
         _buffers.insert(buffer);
         buffer->priv()->register_network(this, handle);
@@ -293,6 +472,7 @@ bool NetworkPrivate::unregister_buffer(Buffer* buffer)
     }
 
     buffer->priv()->unregister_network(this);
+    _statistics.record_buffer_detach();
     if (!_predictor->detach_buffer(buffer_handle)) {
         LOGE << "Error deleting buffer handle " << buffer;
         return false;
@@ -336,6 +516,7 @@ Network& Network::operator=(Network&& rhs)
 
 Network::~Network()
 {
+    d->wait_async();
     d->unregister_buffers();
 }
 
@@ -349,11 +530,37 @@ bool Network::load_model(const void* data, size_t data_size, const char* meta_da
       return d->load_model_data(data, data_size, meta_data);
 }
 
+bool Network::clone(Network& network) const
+{
+    return d->clone(*network.d);
+}
+
+NetworkStatistics Network::statistics() const
+{
+    return d->_statistics.get();
+}
+
+void Network::reset_statistics()
+{
+    d->_statistics.reset();
+}
+
 bool Network::predict()
 {
+    d->wait_async();
     return d->do_predict();
 }
 
+std::future<bool> Network::predict_async(std::function<void(bool success)> on_complete)
+{
+    return d->predict_async(std::move(on_complete));
+}
+
+void Network::wait()
+{
+    d->wait_async();
+}
+
 SynapVersion synap_version()
 {
     return {3, 2, 0};
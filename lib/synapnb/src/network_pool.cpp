@@ -0,0 +1,285 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+#include "synap/network_pool.hpp"
+#include "synap/logging.hpp"
+#include "synap/timer.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace synaptics {
+namespace synap {
+
+
+class NetworkPool::Private {
+public:
+    ~Private() { unload(); }
+
+    // Create the instances, the first one is loaded by the load function, the others are cloned
+    bool load(size_t instances, const function<bool(Network&)>& load_function);
+
+    // Wait for all the pending requests and release the instances
+    void unload();
+
+    std::future<bool> submit(AssignInputs assign_inputs, ReadOutputs read_outputs);
+    void wait();
+    Statistics statistics() const;
+    void reset_statistics();
+
+    size_t size() const { return _instances.size(); }
+
+private:
+    // Network instance with its own worker thread
+    struct Instance {
+        Network net;
+        thread worker;
+
+        // Time spent processing requests since last statistics reset (us)
+        Timer::Duration busy{};
+    };
+
+    // Pending request
+    struct Request {
+        size_t seq;
+        AssignInputs assign_inputs;
+        ReadOutputs read_outputs;
+        promise<bool> result;
+    };
+
+    // Worker thread executing requests on an instance
+    void worker(Instance& instance);
+
+    vector<unique_ptr<Instance>> _instances;
+
+    mutable mutex _mutex;
+    condition_variable _request_available;
+    condition_variable _request_completed;
+    deque<Request> _queue;
+    bool _stop{};
+
+    // Sequence number of the next request to be submitted and of the next one to be completed
+    size_t _next_seq{};
+    size_t _next_completion{};
+
+    // Statistics
+    Timer _stats_timer;
+    size_t _completed{};
+    size_t _failed{};
+    size_t _submitted{};
+    size_t _max_queue_depth{};
+};
+
+
+bool NetworkPool::Private::load(size_t instances, const function<bool(Network&)>& load_function)
+{
+    unload();
+    if (instances == 0) {
+        instances = max(thread::hardware_concurrency(), 1u);
+    }
+
+    Timer tmr;
+    for (size_t i = 0; i < instances; i++) {
+        auto instance = make_unique<Instance>();
+        bool success = i == 0 ?
+            load_function(instance->net) :
+            _instances[0]->net.clone(instance->net) || load_function(instance->net);
+        if (!success) {
+            LOGE << "Failed to create network instance " << i;
+            _instances.clear();
+            return false;
+        }
+        _instances.push_back(std::move(instance));
+    }
+    LOGI << "Created " << instances << " network instances: " << tmr;
+
+    reset_statistics();
+    _stop = false;
+    for (auto& instance : _instances) {
+        instance->worker = thread(&Private::worker, this, ref(*instance));
+    }
+    return true;
+}
+
+
+void NetworkPool::Private::unload()
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        _stop = true;
+        _request_available.notify_all();
+    }
+    for (auto& instance : _instances) {
+        if (instance->worker.joinable()) {
+            instance->worker.join();
+        }
+    }
+    _instances.clear();
+}
+
+
+std::future<bool> NetworkPool::Private::submit(AssignInputs assign_inputs, ReadOutputs read_outputs)
+{
+    lock_guard<mutex> lock(_mutex);
+    if (_instances.empty()) {
+        LOGE << "Network pool not initialized";
+        promise<bool> result;
+        result.set_value(false);
+        return result.get_future();
+    }
+    _queue.push_back({_next_seq++, std::move(assign_inputs), std::move(read_outputs), promise<bool>()});
+    future<bool> result = _queue.back().result.get_future();
+    _submitted++;
+    _max_queue_depth = max(_max_queue_depth, _queue.size());
+    _request_available.notify_one();
+    return result;
+}
+
+
+void NetworkPool::Private::wait()
+{
+    unique_lock<mutex> lock(_mutex);
+    _request_completed.wait(lock, [this] { return _next_completion == _next_seq; });
+}
+
+
+void NetworkPool::Private::worker(Instance& instance)
+{
+    unique_lock<mutex> lock(_mutex);
+    while (true) {
+        _request_available.wait(lock, [this] { return _stop || !_queue.empty(); });
+        if (_queue.empty()) {
+            // Stop requested and no more pending requests
+            break;
+        }
+        Request request = std::move(_queue.front());
+        _queue.pop_front();
+        lock.unlock();
+
+        Timer tmr;
+        bool success = true;
+        if (request.assign_inputs && !request.assign_inputs(instance.net.inputs)) {
+            LOGE << "Failed to assign inputs for request " << request.seq;
+            success = false;
+        }
+        success = success && instance.net.predict();
+        Timer::Duration busy = tmr.get();
+
+        // Results are delivered in submission order. Requests are dequeued in order so the
+        // ones before this are already being processed by other instances.
+        lock.lock();
+        _request_completed.wait(lock, [this, &request] { return _next_completion == request.seq; });
+        lock.unlock();
+
+        tmr.start();
+        if (request.read_outputs) {
+            request.read_outputs(success, instance.net.outputs);
+        }
+        request.result.set_value(success);
+        busy += tmr.get();
+
+        lock.lock();
+        instance.busy += busy;
+        _completed++;
+        _failed += !success;
+        _next_completion++;
+        _request_completed.notify_all();
+    }
+}
+
+
+NetworkPool::Statistics NetworkPool::Private::statistics() const
+{
+    lock_guard<mutex> lock(_mutex);
+    Statistics stats;
+    stats.submitted = _submitted;
+    stats.completed = _completed;
+    stats.failed = _failed;
+    stats.queue_depth = _queue.size();
+    stats.max_queue_depth = _max_queue_depth;
+    Timer::Duration elapsed = max<Timer::Duration>(_stats_timer.get(), 1);
+    for (const auto& instance : _instances) {
+        stats.utilization.push_back(min(float(instance->busy) / elapsed, 1.f));
+    }
+    return stats;
+}
+
+
+void NetworkPool::Private::reset_statistics()
+{
+    lock_guard<mutex> lock(_mutex);
+    _stats_timer.start();
+    _submitted = _next_seq - _next_completion;
+    _completed = 0;
+    _failed = 0;
+    _max_queue_depth = _queue.size();
+    for (auto& instance : _instances) {
+        instance->busy = 0;
+    }
+}
+
+
+//
+// NetworkPool
+//
+
+
+NetworkPool::NetworkPool() : d{new Private()} {}
+
+
+NetworkPool::~NetworkPool() {}
+
+
+bool NetworkPool::load_model(const std::string& model_file, const std::string& meta_file,
+                             size_t instances)
+{
+    return d->load(instances, [&](Network& net) { return net.load_model(model_file, meta_file); });
+}
+
+
+bool NetworkPool::load_model(const void* model_data, size_t model_size, const char* meta_data,
+                             size_t instances)
+{
+    return d->load(instances, [&](Network& net) {
+        return net.load_model(model_data, model_size, meta_data);
+    });
+}
+
+
+size_t NetworkPool::size() const
+{
+    return d->size();
+}
+
+
+std::future<bool> NetworkPool::submit(AssignInputs assign_inputs, ReadOutputs read_outputs)
+{
+    return d->submit(std::move(assign_inputs), std::move(read_outputs));
+}
+
+
+void NetworkPool::wait()
+{
+    d->wait();
+}
+
+
+NetworkPool::Statistics NetworkPool::statistics() const
+{
+    return d->statistics();
+}
+
+
+void NetworkPool::reset_statistics()
+{
+    d->reset_statistics();
+}
+
+
+}  // namespace synap
+}  // namespace synaptics
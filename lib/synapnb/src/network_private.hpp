@@ -9,14 +9,21 @@
 
 #pragma once
 
+#include "network_statistics.hpp"
 #include "predictor.hpp"
 #include "synap/buffer.hpp"
 #include "synap/tensor.hpp"
 #include "synap/types.hpp"
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <vector>
 
 
@@ -30,21 +37,64 @@ class NetworkPrivate {
     friend class Network;
 
 public:
+    ~NetworkPrivate();
+
     bool register_buffer(Buffer* buffer, size_t index, bool is_input);
     bool unregister_buffer(Buffer* buffer);
     bool load_model_file(const std::string& model_file, const std::string& meta_file);
     bool load_model_data(const void* data, size_t data_size, const char* meta_data);
+    bool load_model_blob(const ModelBlob::Ptr& model, const char* meta_data);
+    bool clone(NetworkPrivate& np) const;
 
 protected:
+    void unload();
     void unregister_buffers();
     bool do_predict();
+    bool run_inference(NetworkStatisticsCollector::PhaseDurations& durations);
+    std::future<bool> predict_async(std::function<void(bool)> on_complete);
+    void wait_async();
+    void async_worker();
     std::vector<Tensor> create_tensors(Tensor::Type ttype, const std::vector<TensorAttributes>& tattrs);
 
     std::unique_ptr<Predictor> _predictor{};
 
+    // Model data, kept to be able to clone the network if the predictor doesn't support cloning.
+    // Only kept when owned (e.g. memory-mapped file), memory owned by the caller is not retained.
+    ModelBlob::Ptr _model;
+
+    // True if the model can be loaded again (model data retained or bundle directory)
+    bool _reloadable{};
+
+    // Metadata as provided to the predictor when loading the model
+    std::shared_ptr<const NetworkMetadata> _load_meta;
+
+    // Metadata after loading the model, shared with the clones of this network
+    std::shared_ptr<const NetworkMetadata> _meta;
+
+    /// Pending asynchronous inference request
+    struct AsyncRequest {
+        std::promise<bool> result;
+        std::function<void(bool)> on_complete;
+    };
+
+    // Asynchronous inference support. The worker thread is only started on first use.
+    std::thread _async_thread;
+    std::mutex _async_mutex;
+    std::condition_variable _async_cv;
+    std::condition_variable _async_done;
+    std::deque<AsyncRequest> _async_queue;
+    bool _async_busy{};
+    bool _async_stop{};
+
+    // Serializes the inferences done by predict() and by the worker thread
+    std::mutex _predict_mutex;
+
     std::vector<Tensor> _inputs;
     std::vector<Tensor> _outputs;
     std::set<Buffer*> _buffers;
+
+    // Runtime statistics
+    NetworkStatisticsCollector _statistics;
 };
 
 
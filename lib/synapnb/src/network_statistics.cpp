@@ -0,0 +1,152 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+#include "network_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace synaptics {
+namespace synap {
+
+
+//
+// LatencyHistogram
+//
+
+
+size_t LatencyHistogram::bucket_index(uint64_t value)
+{
+    constexpr uint64_t sub_count = 1 << sub_bits;
+    if (value < sub_count) {
+        return value;
+    }
+    int exponent = 63 - __builtin_clzll(value);
+    if (exponent > max_exponent) {
+        return bucket_count - 1;
+    }
+    uint64_t sub = (value >> (exponent - sub_bits)) & (sub_count - 1);
+    return ((exponent - sub_bits + 1) << sub_bits) + sub;
+}
+
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index)
+{
+    constexpr uint64_t sub_count = 1 << sub_bits;
+    if (index < sub_count) {
+        return index;
+    }
+    int exponent = (index >> sub_bits) + sub_bits - 1;
+    uint64_t sub = index & (sub_count - 1);
+    uint64_t lower = (sub_count + sub) << (exponent - sub_bits);
+    return lower + (uint64_t{1} << (exponent - sub_bits)) - 1;
+}
+
+
+void LatencyHistogram::add(Timer::Duration duration)
+{
+    uint64_t value = max<Timer::Duration>(duration, 0);
+    _buckets[bucket_index(value)]++;
+    _count++;
+    _total += value;
+    _max = max(_max, value);
+}
+
+
+uint64_t LatencyHistogram::percentile(float p) const
+{
+    uint64_t target = max<uint64_t>(ceil(p * _count), 1);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < bucket_count; i++) {
+        cumulative += _buckets[i];
+        if (cumulative >= target) {
+            return min(bucket_upper_bound(i), _max);
+        }
+    }
+    return _max;
+}
+
+
+LatencyStatistics LatencyHistogram::get() const
+{
+    LatencyStatistics stats;
+    stats.count = _count;
+    stats.total = _total;
+    stats.max = _max;
+    if (_count) {
+        stats.p50 = percentile(0.50);
+        stats.p90 = percentile(0.90);
+        stats.p99 = percentile(0.99);
+    }
+    return stats;
+}
+
+
+//
+// NetworkStatisticsCollector
+//
+
+
+void NetworkStatisticsCollector::record_inference(const PhaseDurations& durations,
+                                                  Timer::Duration total, bool success)
+{
+    lock_guard<mutex> lock(_mutex);
+    _inferences++;
+    if (!success) {
+        _failures++;
+        return;
+    }
+    for (size_t i = 0; i < phase_count; i++) {
+        _phases[i].add(durations[i]);
+    }
+    _total.add(total);
+}
+
+
+void NetworkStatisticsCollector::record_buffer_attach()
+{
+    lock_guard<mutex> lock(_mutex);
+    _buffer_attach++;
+}
+
+
+void NetworkStatisticsCollector::record_buffer_detach()
+{
+    lock_guard<mutex> lock(_mutex);
+    _buffer_detach++;
+}
+
+
+NetworkStatistics NetworkStatisticsCollector::get() const
+{
+    lock_guard<mutex> lock(_mutex);
+    NetworkStatistics stats;
+    stats.inferences = _inferences;
+    stats.failures = _failures;
+    stats.buffer_validation = _phases[buffer_validation].get();
+    stats.cache_flush = _phases[cache_flush].get();
+    stats.predict = _phases[predict].get();
+    stats.cache_invalidate = _phases[cache_invalidate].get();
+    stats.total = _total.get();
+    stats.buffer_attach = _buffer_attach;
+    stats.buffer_detach = _buffer_detach;
+    return stats;
+}
+
+
+void NetworkStatisticsCollector::reset()
+{
+    lock_guard<mutex> lock(_mutex);
+    _phases = {};
+    _total = {};
+    _inferences = 0;
+    _failures = 0;
+    _buffer_attach = 0;
+    _buffer_detach = 0;
+}
+
+
+}  // namespace synap
+}  // namespace synaptics
@@ -0,0 +1,81 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Network runtime statistics collection.
+///
+
+#pragma once
+
+#include "synap/network_statistics.hpp"
+#include "synap/timer.hpp"
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+namespace synaptics {
+namespace synap {
+
+/// Histogram of durations with fixed logarithmic buckets.
+/// Each power of two is divided in 4 buckets, this gives a resolution better than 25%
+/// with a small fixed number of buckets and no allocation.
+class LatencyHistogram {
+public:
+    /// Add a measurement
+    void add(Timer::Duration duration);
+
+    /// @return statistics of the measurements done so far
+    LatencyStatistics get() const;
+
+private:
+    static constexpr int sub_bits = 2;
+    static constexpr int max_exponent = 36;
+    static constexpr size_t bucket_count = (max_exponent - sub_bits + 2) << sub_bits;
+
+    static size_t bucket_index(uint64_t value);
+    static uint64_t bucket_upper_bound(size_t index);
+    uint64_t percentile(float p) const;
+
+    std::array<uint32_t, bucket_count> _buckets{};
+    uint64_t _count{};
+    uint64_t _total{};
+    uint64_t _max{};
+};
+
+
+/// Collect the runtime statistics of a network.
+/// Each inference is recorded at once so the overhead is a single uncontended lock.
+class NetworkStatisticsCollector {
+public:
+    /// Phases of an inference
+    enum Phase { buffer_validation, cache_flush, predict, cache_invalidate, phase_count };
+
+    /// Durations of the phases of an inference
+    typedef std::array<Timer::Duration, phase_count> PhaseDurations;
+
+    /// Record an inference.
+    /// Durations are only taken into account for successful inferences.
+    void record_inference(const PhaseDurations& durations, Timer::Duration total, bool success);
+
+    /// Record a buffer attach or detach
+    void record_buffer_attach();
+    void record_buffer_detach();
+
+    /// @return statistics collected so far
+    NetworkStatistics get() const;
+
+    /// Clear all statistics
+    void reset();
+
+private:
+    mutable std::mutex _mutex;
+    std::array<LatencyHistogram, phase_count> _phases;
+    LatencyHistogram _total;
+    uint64_t _inferences{};
+    uint64_t _failures{};
+    uint64_t _buffer_attach{};
+    uint64_t _buffer_detach{};
+};
+
+}  // namespace synap
+}  // namespace synaptics
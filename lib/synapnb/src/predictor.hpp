@@ -5,6 +5,8 @@
 
 #include "synap/buffer.hpp"
 #include "synap/metadata.hpp"
+#include "synap/model_blob.hpp"
+#include <memory>
 
 namespace synaptics {
 namespace synap {
@@ -19,14 +21,23 @@ public:
     virtual ~Predictor() {}
 
     /// Load a model.
-    /// @param model     model data, as from e.g. fread()
-    ///                  model data will be deallocated at the end of this method, if the
-    ///                  predictor needs model data to be persistent it should make a local copy.
-    /// @param size      model size in bytes
+    /// @param model     model data (can be nullptr for bundles specified as a directory)
+    ///                  the blob may refer to memory only valid until the end of this method,
+    ///                  if the predictor needs model data to be persistent it should keep a
+    ///                  reference to ModelBlob::persistent(model), this avoids any copy when
+    ///                  the model has been memory-mapped from a file.
     /// @param meta      model's metadata.
     ///                  these information can be read/verified/updated as needed.
     /// @return          true if success
-    virtual bool load_model(const void* model, size_t size, NetworkMetadata* meta) = 0;
+    virtual bool load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta) = 0;
+
+    /// Create a new predictor for the model already loaded in this one.
+    /// The new predictor has its own execution context but shares with this one all the
+    /// immutable parts of the model (model data, parsed model, compiled modules...).
+    /// The metadata of the new predictor are the same as the ones of this predictor.
+    /// @return          new predictor, nullptr if not supported by the delegate,
+    ///                  in this case the model will be loaded again from its data
+    virtual std::unique_ptr<Predictor> clone() const { return nullptr; }
 
     /// Run inference.
     /// @return          true if success
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "predictor_bundle.hpp"
+#include "network_private.hpp"
 #include "synap/string_utils.hpp"
 
 #ifdef SYNAP_FILE_BASED_BUNDLE
@@ -11,12 +12,21 @@
 
 #include "synap/logging.hpp"
 #include "synap/metadata.hpp"
+#include "synap/trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
 
 using namespace std;
 
 namespace synaptics {
 namespace synap {
 
+// Number of successful parallel inferences used to measure the actual subgraph latencies.
+// The very first one is not included since it is usually slower.
+static constexpr int calibration_runs = 4;
+
 
 PredictorBundle::PredictorBundle() : Predictor()
 {
@@ -47,7 +57,7 @@ bool PredictorBundle::set_model_input(size_t input_index, Tensor& in_tensor)
 }
 
 
-bool PredictorBundle::load_model(const void* model, size_t size, NetworkMetadata* meta)
+bool PredictorBundle::load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta)
 {
     // Get bundle root path from meta info
     size_t root_dir_ix = format_parse::value_pos(meta->delegate, "dir");
@@ -55,7 +65,7 @@ bool PredictorBundle::load_model(const void* model, size_t size, NetworkMetadata
     if (root_dir_ix == string::npos) {
         auto bundle_zip = new BundleParserZip;
         bundle.reset(bundle_zip);
-        if (!bundle_zip->init(model, size)) {
+        if (!model || !bundle_zip->init(model)) {
             LOGE << "Error parsing bundle model";
             return false;
         }
@@ -77,31 +87,75 @@ bool PredictorBundle::load_model(const void* model, size_t size, NetworkMetadata
         #endif
     }
 
-    // Create subgraphs
+    // Keep the topology of the bundle, this is all we need to connect the subgraphs of a clone
     for (const auto& graph_info : bundle->graph_info()) {
-        Graph graph;
-        if (!graph_info.model_data.empty()) {
-            if (!graph.net.load_model(graph_info.model_data.data(), graph_info.model_data.size(),
-                                graph_info.meta_data.c_str())) {
-                LOGE << "Missing model data for bundle graph";
-                return false;
-            }
-        } else {
-            if (!graph.net.load_model(graph_info.model, graph_info.meta)) {
-                LOGE << "Loading bundle graph " << graph_info.model << " failed";
-                return false;
-            }
+        _graph_inputs.push_back(graph_info.inputs);
+    }
+    _bundle_outputs = bundle->outputs();
+    _bundle_parallel_limit = bundle->parallel_limit();
+    _pipeline_requested = format_parse::get_bool(meta->delegate, "pipeline", bundle->pipeline());
+
+    // Create subgraphs. Loading a subgraph doesn't depend on the others so they are all loaded
+    // in parallel, connections between them are done afterwards.
+    const auto& graph_infos = bundle->graph_info();
+    _graphs.resize(graph_infos.size());
+    atomic<bool> loaded{true};
+    {
+        Timer tmr;
+        ThreadPool loaders(min<size_t>(graph_infos.size(), thread::hardware_concurrency()));
+        for (size_t graph_ix = 0; graph_ix < graph_infos.size(); graph_ix++) {
+            loaders.post([this, &graph_infos, &loaded, graph_ix] {
+                if (!load_graph(_graphs[graph_ix], graph_infos[graph_ix])) {
+                    loaded = false;
+                }
+            });
         }
-        _graphs.push_back(std::move(graph));
+        loaders.wait();
+        LOGV << "Loaded " << graph_infos.size() << " bundle graphs with " << loaders.size()
+             << " threads: " << tmr;
     }
+    if (!loaded) {
+        return false;
+    }
+
+    return connect_graphs(meta);
+}
+
 
+std::unique_ptr<Predictor> PredictorBundle::clone() const
+{
+    auto bundle = make_unique<PredictorBundle>();
+    bundle->_graph_inputs = _graph_inputs;
+    bundle->_bundle_outputs = _bundle_outputs;
+    bundle->_bundle_parallel_limit = _bundle_parallel_limit;
+    bundle->_pipeline_requested = _pipeline_requested;
+
+    // Each subgraph shares its model with the corresponding subgraph of this bundle
+    bundle->_graphs.resize(_graphs.size());
+    for (size_t graph_ix = 0; graph_ix < _graphs.size(); graph_ix++) {
+        if (!_graphs[graph_ix].net.clone(bundle->_graphs[graph_ix].net)) {
+            LOGE << "Cloning bundle graph " << graph_ix << " failed";
+            return nullptr;
+        }
+    }
+
+    NetworkMetadata meta;
+    if (!bundle->connect_graphs(&meta)) {
+        return nullptr;
+    }
+    return bundle;
+}
+
+
+bool PredictorBundle::connect_graphs(NetworkMetadata* meta)
+{
     // Connect subgraphs and collect the list of model inputs
     bool success = true;
     for (size_t graph_ix = 0; graph_ix < _graphs.size(); graph_ix++) {
         _graphs[graph_ix].index = graph_ix;
-        const auto& graph_info = bundle->graph_info()[graph_ix];
-        for (size_t in_ix = 0; in_ix < graph_info.inputs.size(); in_ix++) {
-            const auto& in = graph_info.inputs[in_ix];
+        const auto& graph_inputs = _graph_inputs[graph_ix];
+        for (size_t in_ix = 0; in_ix < graph_inputs.size(); in_ix++) {
+            const auto& in = graph_inputs[in_ix];
             Tensor& in_tensor = _graphs[graph_ix].net.inputs[in_ix];
             if (in.subgraph_index < 0) {
                 // This input comes directly from the inputs of the bundle model
@@ -114,23 +168,44 @@ bool PredictorBundle::load_model(const void* model, size_t size, NetworkMetadata
                 success &= in_tensor.set_buffer(out_tensor.buffer());
                 
                 // Create the graphs depedency
-                _graphs[graph_ix].dependencies.push_back(&_graphs[in.subgraph_index]);
+                Graph* dependency = &_graphs[in.subgraph_index];
+                auto& dependencies = _graphs[graph_ix].dependencies;
+                if (find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end()) {
+                    dependencies.push_back(dependency);
+                    dependency->dependents.push_back(&_graphs[graph_ix]);
+                }
             }
         }
     }
 
     // Get list of model outputs
-    for (const auto& out : bundle->outputs()) {
+    for (const auto& out : _bundle_outputs) {
         _outputs.push_back(&_graphs[out.subgraph_index].net.outputs[out.tensor_index]);
     }
 
-    // Get max parallelism level
-    // @todo: implement a more intelligent "parallelizablility" analysis or rely on
-    // converter to set _parallel_limit at 1 if the bundle is not parallelizable
-    bool parallelizable = _graphs.size() > 1;
-    _parallel_limit = parallelizable ? bundle->parallel_limit() : 1;
+    if (!analyze_graphs()) {
+        return false;
+    }
+
+    // Get max parallelism level. If not specified in the bundle use the max number of subgraphs
+    // that can actually be executed at the same time.
+    int max_width = max_level_width();
+    _parallel_limit = _bundle_parallel_limit;
+    if (_parallel_limit <= 0 || _parallel_limit > max_width) {
+        _parallel_limit = max_width;
+    }
+    if (_pipeline_requested && _graphs.size() > 1) {
+        if (!setup_pipeline()) {
+            return false;
+        }
+        LOGV << "Bundle pipelined inference with " << _graphs.size() << " stages";
+        _workers = make_unique<ThreadPool>(_graphs.size());
+    }
+    else if (_parallel_limit != 1) {
+        LOGV << "Bundle parallel inference with " << _parallel_limit << " workers";
+        _workers = make_unique<ThreadPool>(_parallel_limit);
+    }
 
-    
     // Adjust the size of the in/out tensor info in meta.
     // Actual info will not be used since we will alias the in/out tensors of the subgraphs.
     meta->inputs.resize(_inputs.size());
@@ -140,6 +215,146 @@ bool PredictorBundle::load_model(const void* model, size_t size, NetworkMetadata
 }
 
 
+bool PredictorBundle::load_graph(Graph& graph, const BundleParser::SubGraphInfo& graph_info)
+{
+    if (graph_info.model_data) {
+        // Model data may refer directly to the bundle data, avoid copying them
+        if (!graph.net.d->load_model_blob(graph_info.model_data, graph_info.meta_data.c_str())) {
+            LOGE << "Missing model data for bundle graph";
+            return false;
+        }
+    } else {
+        if (!graph.net.load_model(graph_info.model, graph_info.meta)) {
+            LOGE << "Loading bundle graph " << graph_info.model << " failed";
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool PredictorBundle::setup_pipeline()
+{
+    // Only a linear chain of subgraphs can be pipelined. Since each stage works on a different
+    // frame, bundle inputs can only go to the first stage and bundle outputs can only come
+    // from the last one.
+    for (size_t stage = 0; stage < _order.size(); stage++) {
+        const Graph* graph = _order[stage];
+        bool linked_to_previous = stage == 0 ?
+            graph->dependencies.empty() :
+            graph->dependencies.size() == 1 && graph->dependencies[0] == _order[stage - 1];
+        bool linked_to_next = stage == _order.size() - 1 ?
+            graph->dependents.empty() :
+            graph->dependents.size() == 1 && graph->dependents[0] == _order[stage + 1];
+        if (!linked_to_previous || !linked_to_next) {
+            LOGE << "Pipelined execution requires a linear chain of subgraphs";
+            return false;
+        }
+    }
+    const int first_graph = _order.front()->index;
+    const int last_graph = _order.back()->index;
+    for (const auto& out : _bundle_outputs) {
+        if (out.subgraph_index != last_graph) {
+            LOGE << "Pipelined execution requires all bundle outputs to come from the last subgraph";
+            return false;
+        }
+    }
+
+    // Create a second buffer for each intermediate output so that a stage can write the
+    // results of one frame while the next stage reads the results of the previous one
+    for (const Graph& graph : _graphs) {
+        const auto& graph_inputs = _graph_inputs[graph.index];
+        for (size_t in_ix = 0; in_ix < graph_inputs.size(); in_ix++) {
+            const auto& in = graph_inputs[in_ix];
+            if (in.subgraph_index < 0 && graph.index != first_graph) {
+                LOGE << "Pipelined execution requires all bundle inputs to go to the first subgraph";
+                return false;
+            }
+            if (in.subgraph_index < 0) {
+                continue;
+            }
+            Tensor* out_tensor = &_graphs[in.subgraph_index].net.outputs[in.tensor_index];
+            Tensor* in_tensor = &_graphs[graph.index].net.inputs[in_ix];
+            auto link = find_if(_pipeline_links.begin(), _pipeline_links.end(),
+                                [out_tensor](const PipelineLink& l) { return l.out == out_tensor; });
+            if (link != _pipeline_links.end()) {
+                link->ins.push_back(in_tensor);
+                continue;
+            }
+            _pipeline_buffers.push_back(make_unique<Buffer>(out_tensor->size()));
+            _pipeline_links.push_back({out_tensor, {in_tensor}, {out_tensor->buffer(), _pipeline_buffers.back().get()}});
+        }
+    }
+
+    _pipelined = true;
+    return true;
+}
+
+
+bool PredictorBundle::analyze_graphs()
+{
+    // Topological sort
+    vector<size_t> pending(_graphs.size());
+    deque<Graph*> ready;
+    for (Graph& graph: _graphs) {
+        pending[graph.index] = graph.dependencies.size();
+        if (pending[graph.index] == 0) {
+            ready.push_back(&graph);
+        }
+    }
+    _order.clear();
+    while (!ready.empty()) {
+        Graph* graph = ready.front();
+        ready.pop_front();
+        _order.push_back(graph);
+        for (Graph* dependent: graph->dependents) {
+            if (--pending[dependent->index] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+    if (_order.size() != _graphs.size()) {
+        LOGE << "Circular dependency between bundle graphs";
+        return false;
+    }
+
+    for (Graph* graph: _order) {
+        graph->level = 0;
+        for (const Graph* dependency: graph->dependencies) {
+            graph->level = max(graph->level, dependency->level + 1);
+        }
+    }
+    update_priorities();
+    return true;
+}
+
+
+void PredictorBundle::update_priorities()
+{
+    for (auto it = _order.rbegin(); it != _order.rend(); ++it) {
+        Graph* graph = *it;
+        float max_priority = 0;
+        for (const Graph* dependent: graph->dependents) {
+            max_priority = max(max_priority, dependent->priority);
+        }
+        graph->priority = graph->weight + max_priority;
+        LOGV << "Bundle graph " << graph->index << " level: " << graph->level
+             << " weight: " << graph->weight << " priority: " << graph->priority;
+    }
+}
+
+
+size_t PredictorBundle::max_level_width() const
+{
+    vector<size_t> width;
+    for (const Graph& graph: _graphs) {
+        width.resize(max<size_t>(width.size(), graph.level + 1));
+        width[graph.level]++;
+    }
+    return width.empty() ? 1 : *max_element(width.begin(), width.end());
+}
+
+
 Tensor* PredictorBundle::get_tensor(int32_t index, bool is_input)
 {
     vector<Tensor*>& tensors = is_input ? _inputs : _outputs;
@@ -181,9 +396,9 @@ bool PredictorBundle::set_buffer(Buffer* buffer, int32_t index, bool is_input, B
 bool PredictorBundle::predict_sequential()
 {
     LOGI << "Starting bundle sequential inference";
-    for (size_t i = 0; i < _graphs.size(); i++) {
-        if (!_graphs[i].net.predict()) {
-            LOGE << "Inference with subgraph " << i << " failed";
+    for (Graph* graph: _order) {
+        if (!predict_graph(*graph)) {
+            LOGE << "Inference with subgraph " << graph->index << " failed";
             return false;
         }
     }
@@ -193,54 +408,144 @@ bool PredictorBundle::predict_sequential()
 
 bool PredictorBundle::predict_parallel()
 {
-    // Start execution of all graphs
+    // Start execution of all the graphs without dependencies,
+    // the others are scheduled as soon as their dependencies complete
     LOGI << "Starting bundle parallel inference";
-    {
-        lock_guard lock(_inference_mutex);
-        for (Graph& graph: _graphs) {
-            graph.success = async(launch::async, [&graph, this]{ return run_graph(graph); } );
+    unique_lock lock(_inference_mutex);
+    _ready.clear();
+    _remaining = _graphs.size();
+    _success = true;
+    for (Graph& graph: _graphs) {
+        graph.pending = graph.dependencies.size();
+        graph.failed = false;
+        if (graph.pending == 0) {
+            _ready.push_back(&graph);
         }
     }
+    dispatch_ready_graphs();
 
-    // Wait until all subgraphs have finished execution and check that everything went well
+    // Wait until all subgraphs have finished execution
     LOGV << "Waiting for bundle inference to complete";
+    _inference_done.wait(lock, [this] { return _remaining == 0; });
+    assert(_in_progress == 0);
+
+    if (_success && _run_count <= calibration_runs) {
+        if (_run_count > 0) {
+            for (Graph& graph: _graphs) {
+                graph.latency += graph.run_latency;
+            }
+        }
+        if (_run_count == calibration_runs) {
+            // Use measured latencies to refine the critical path of the bundle
+            for (Graph& graph: _graphs) {
+                graph.weight = max(graph.latency / float(calibration_runs), 1.f);
+            }
+            update_priorities();
+        }
+        _run_count++;
+    }
+    return _success;
+}
+
+
+bool PredictorBundle::predict_pipelined()
+{
+    // Rotate intermediate buffers: each stage writes the buffer the next stage will read
+    // at the next step, and reads the one written by the previous stage at the previous step
+    const size_t step = _pipeline_step++;
     bool success = true;
-    for (Graph& graph: _graphs) {
-        success &= graph.success.get();
+    for (auto& link: _pipeline_links) {
+        success &= link.out->set_buffer(link.buffers[step % 2]);
+        for (Tensor* in: link.ins) {
+            success &= in->set_buffer(link.buffers[(step + 1) % 2]);
+        }
     }
-    assert(_in_progress == 0);
-    return success;
+    if (!success) {
+        LOGE << "Failed to setup bundle pipeline buffers";
+        return false;
+    }
+
+    // During the first steps the last stages don't have any valid data to process yet
+    const size_t active_stages = min(step + 1, _order.size());
+    LOGI << "Starting bundle pipelined inference, step " << step;
+    unique_lock lock(_inference_mutex);
+    _remaining = active_stages;
+    _success = true;
+    for (size_t stage = 0; stage < active_stages; stage++) {
+        Graph* graph = _order[stage];
+        _workers->post([this, graph] {
+            bool success = predict_graph(*graph);
+            if (!success) {
+                LOGE << "Inference for bundle stage: " << graph->index << " failed";
+            }
+            lock_guard lock(_inference_mutex);
+            _success &= success;
+            if (--_remaining == 0) {
+                _inference_done.notify_all();
+            }
+        });
+    }
+    _inference_done.wait(lock, [this] { return _remaining == 0; });
+    return _success;
+}
+
+
+bool PredictorBundle::predict_graph(Graph& graph)
+{
+    TraceScope trace("bundle_graph", "bundle", graph.index);
+    return graph.net.predict();
 }
 
 
 bool PredictorBundle::predict()
 {
-    bool success  = _parallel_limit == 1 ? predict_sequential() : predict_parallel();
+    bool success = _pipelined ? predict_pipelined() :
+                   _parallel_limit == 1 ? predict_sequential() : predict_parallel();
     LOGV << "Bundle inference completed, success: " << success;
     return success;
 }
 
 
-bool PredictorBundle::run_graph(Graph& graph)
+void PredictorBundle::dispatch_ready_graphs()
 {
-    bool success = true;
-
-    // We can proceed only after init so that all graphs have been started all our inputs
-    // processed; taking the lock and release it immediately achieves that.
-    { lock_guard lock{_inference_mutex}; }
-  
-    for (auto& in: graph.dependencies) {
-        success &= in->success.get();
+    while (!_ready.empty() && _in_progress < _workers->size()) {
+        // Start the graph with the longest critical path first
+        auto next = max_element(_ready.begin(), _ready.end(), [](const Graph* a, const Graph* b) {
+            return a->priority < b->priority || (a->priority == b->priority && a->index > b->index);
+        });
+        Graph* graph = *next;
+        _ready.erase(next);
+        _in_progress++;
+        _workers->post([this, graph] { run_graph(*graph); });
     }
+}
 
-    if (_parallel_limit) {
-        // Make sure not to exceed max specified parallelism
-        unique_lock lock(_inference_mutex);
-        _inference_done.wait(lock, [this]{ return _in_progress < _parallel_limit; });
-        _in_progress++;
+
+void PredictorBundle::graph_completed(Graph& graph, bool success)
+{
+    _success &= success;
+    _remaining--;
+    for (Graph* dependent: graph.dependents) {
+        dependent->failed |= !success;
+        if (--dependent->pending == 0) {
+            if (dependent->failed) {
+                // No point in executing a graph whose inputs are not valid
+                LOGE << "Inference for bundle graph: " << dependent->index << " skipped";
+                graph_completed(*dependent, false);
+            }
+            else {
+                _ready.push_back(dependent);
+            }
+        }
     }
+}
+
 
-    success = success && graph.net.predict();
+void PredictorBundle::run_graph(Graph& graph)
+{
+    Timer tmr;
+    bool success = predict_graph(graph);
+    Timer::Duration latency = tmr.get();
     if (success) {
         LOGV << "Inference for bundle graph: " << graph.index << " completed";
     }
@@ -248,13 +553,14 @@ bool PredictorBundle::run_graph(Graph& graph)
         LOGE << "Inference for bundle graph: " << graph.index << " failed";
     }
 
-    if (_parallel_limit) {
-        lock_guard lock(_inference_mutex);
-        _in_progress--;
-        assert(_in_progress >= 0);
+    lock_guard lock(_inference_mutex);
+    graph.run_latency = latency;
+    _in_progress--;
+    graph_completed(graph, success);
+    dispatch_ready_graphs();
+    if (_remaining == 0) {
         _inference_done.notify_all();
     }
-    return success;
 }
 
 
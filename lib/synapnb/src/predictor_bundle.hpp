@@ -5,20 +5,29 @@
 #include <cstdint>
 #include <stddef.h>
 #include "predictor.hpp"
+#include "synap/bundle_parser.hpp"
 #include "synap/network.hpp"
+#include "synap/thread_pool.hpp"
+#include "synap/timer.hpp"
 #include <mutex>
-#include <future>
 #include <condition_variable>
 
 namespace synaptics {
 namespace synap {
 
-class BundleParser;
-
 /// PredictorBundle
 /// This predictor is actually a container of sub-Networks.
 /// It doesn't do much in itself, it just initializes, connects and executes the subnetworks
-/// that will do the actual inference (execution order is definition order).
+/// that will do the actual inference.
+/// When parallel execution is enabled, ready subgraphs are dispatched longest critical path first.
+/// The critical path is initially estimated from the structure of the bundle and then refined
+/// with the subgraph latencies measured during the first inferences.
+/// A bundle consisting of a linear chain of subgraphs can also be executed in pipelined mode
+/// (enabled with "pipeline" in the bundle information or in the delegate options): each predict()
+/// runs all the stages in parallel, stage k processing the data provided k predictions before.
+/// Intermediate results are double-buffered so that consecutive stages never share a buffer.
+/// In this mode the outputs correspond to the inputs of n_stages - 1 predictions before, and are
+/// not meaningful for the first n_stages - 1 predictions.
 /// Tensors of a bundle network are simply aliases (references to) the actual tensors in the
 /// contained subnetworks. Subnetworks are connected internally by sharing the buffers of the
 /// corresponding out/in tensors.
@@ -31,7 +40,8 @@ public:
     PredictorBundle();
     ~PredictorBundle();
 
-    bool load_model(const void* model, size_t size, NetworkMetadata* meta) override;
+    bool load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta) override;
+    std::unique_ptr<Predictor> clone() const override;
     bool predict() override;
 
     BufferAttachment attach_buffer(Buffer* buffer, int32_t index, bool is_input) override;
@@ -48,8 +58,29 @@ private:
         // Graphs on which this graph depends (must be completed before we can start this one)
         std::vector<Graph*> dependencies;
 
-        // True if inference completed successfully
-        std::shared_future<bool> success;
+        // Graphs depending on this one
+        std::vector<Graph*> dependents;
+
+        // Number of dependencies not yet completed in the current inference
+        size_t pending{};
+
+        // True if a dependency failed in the current inference
+        bool failed{};
+
+        // Length of the longest chain of dependencies leading to this graph
+        int level{};
+
+        // Estimated execution time of this graph (1 until measured)
+        float weight{1};
+
+        // Weight of the critical path from this graph to the end of the bundle
+        float priority{};
+
+        // Latency measured in the current inference (us)
+        Timer::Duration run_latency{};
+
+        // Total latency measured during calibration inferences (us)
+        Timer::Duration latency{};
 
         // Graph own index (handy to have)
         int index{};
@@ -58,14 +89,54 @@ private:
     // Set the tensor as input of the bundle model
     bool set_model_input(size_t input_index, Tensor& in_tensor);
 
-    // Execute all the subgraphs sequentially in definition order
+    // Load the network of a subgraph
+    bool load_graph(Graph& graph, const BundleParser::SubGraphInfo& graph_info);
+
+    // Connect the loaded subgraphs according to the bundle topology and setup execution
+    bool connect_graphs(NetworkMetadata* meta);
+
+    // Setup double-buffered connections between the stages of a linear chain of subgraphs
+    bool setup_pipeline();
+
+    // Compute topological order and levels of the subgraphs, fails if dependencies are circular
+    bool analyze_graphs();
+
+    // Compute critical-path priorities from the current subgraph weights
+    void update_priorities();
+
+    // Max number of subgraphs in the same level, this is the useful parallelism of the bundle
+    size_t max_level_width() const;
+
+    // Perform inference on a single subgraph
+    bool predict_graph(Graph& graph);
+
+    // Execute all the subgraphs sequentially in topological order
     bool predict_sequential();
 
     // Execute all the subgraphs in parallel whenever possible
     bool predict_parallel();
 
-    // Graph execution handler, perform inference and send notification when completed
-    bool run_graph(Graph& graph);
+    // Execute all the stages of a pipelined bundle in parallel, each on a different frame
+    bool predict_pipelined();
+
+    // Graph execution handler, perform inference and schedule the graphs depending on it
+    void run_graph(Graph& graph);
+
+    // Mark graph as completed and update the ready queue (called with _inference_mutex locked)
+    void graph_completed(Graph& graph, bool success);
+
+    // Dispatch ready graphs to the worker threads (called with _inference_mutex locked)
+    void dispatch_ready_graphs();
+
+    // Inputs of each subgraph and outputs of the bundle as specified in the bundle information
+    std::vector<std::vector<BundleParser::TensorInfo>> _graph_inputs;
+    std::vector<BundleParser::TensorInfo> _bundle_outputs;
+
+    // Max number of parallel executions specified in the bundle information (0: not specified)
+    int _bundle_parallel_limit{};
+
+    // True if pipelined execution has been requested
+    bool _pipeline_requested{};
 
     // Max number of parallel executions (0: unlimited)
     int _parallel_limit{};
@@ -77,12 +148,49 @@ private:
     // Subgraphs in the bundle
     std::vector<Graph> _graphs;
 
+    // Subgraphs in topological order
+    std::vector<Graph*> _order;
+
+    // Number of successful parallel inferences done so far, used to calibrate the subgraph weights
+    int _run_count{};
+
+    // Connection between an output of a pipeline stage and the inputs of the next stage
+    struct PipelineLink {
+        Tensor* out;
+        std::vector<Tensor*> ins;
+        Buffer* buffers[2];
+    };
+
+    // True if pipelined execution is enabled
+    bool _pipelined{};
+
+    // Pipeline links and additional buffers to double-buffer them.
+    // Declared after _graphs so that the buffers are released before the subgraphs.
+    std::vector<PipelineLink> _pipeline_links;
+    std::vector<std::unique_ptr<Buffer>> _pipeline_buffers;
+
+    // Number of pipelined inferences done so far
+    size_t _pipeline_step{};
+
+    // Worker threads for parallel inference, created once at load time.
+    // The pool size is the max number of subgraphs executed in parallel.
+    std::unique_ptr<ThreadPool> _workers;
+
+    // Graphs whose dependencies are satisfied, waiting for a free worker
+    std::vector<Graph*> _ready;
+
     // Condition variables to syncronize parallel inferences
     std::mutex _inference_mutex;
     std::condition_variable _inference_done;
 
     // Number of inferences in progress
-    int _in_progress{};
+    size_t _in_progress{};
+
+    // Number of graphs not yet completed in the current inference
+    size_t _remaining{};
+
+    // Overall result of the current inference
+    bool _success{};
 };
 
 }  // namespace synap
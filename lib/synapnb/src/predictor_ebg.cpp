@@ -20,15 +20,21 @@ bool PredictorEBG::init()
         LOGE << "Failed to initialize synap device";
         return false;
     }
-    if (setenv("VSI_NN_LOG_LEVEL", "0", 0) != 0) {
+    // Done only once since networks can be loaded from multiple threads
+    static const bool log_disabled = setenv("VSI_NN_LOG_LEVEL", "0", 0) == 0;
+    if (!log_disabled) {
         LOGW << "Failed to disable ovxlib log messages";
     }
     return true;
 }
 
 
-bool PredictorEBG::load_model(const void* model, size_t size, NetworkMetadata* meta)
+bool PredictorEBG::load_model(const ModelBlob::Ptr& model_blob, NetworkMetadata* meta)
 {
+    // Model data are copied by the driver, no need to keep a reference to them
+    const void* model = model_blob ? model_blob->data() : nullptr;
+    size_t size = model_blob ? model_blob->size() : 0;
+
     // Init NPU
     if (!init()) {
         return false;
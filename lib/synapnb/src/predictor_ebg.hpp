@@ -16,7 +16,7 @@ public:
     ~PredictorEBG();
 
     static bool init();
-    bool load_model(const void* model, size_t size, NetworkMetadata* meta) override;
+    bool load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta) override;
     bool predict() override;
 
     BufferAttachment attach_buffer(Buffer* buffer, int32_t index, bool is_input) override;
@@ -13,8 +13,12 @@ using namespace std;
 namespace synaptics {
 namespace synap {
 
-bool PredictorONNX::load_model(const void* model, size_t size, NetworkMetadata* meta)
+bool PredictorONNX::load_model(const ModelBlob::Ptr& model_blob, NetworkMetadata* meta)
 {
+    // Model data are parsed when creating the session, no need to keep a reference to them
+    const void* model = model_blob ? model_blob->data() : nullptr;
+    size_t size = model_blob ? model_blob->size() : 0;
+
     if (!model || size <= 0) {
         LOGE << "invalid model data or size";
         return false;
@@ -22,10 +26,11 @@ bool PredictorONNX::load_model(const void* model, size_t size, NetworkMetadata*
 
     LOGV << "Preparing network onnxruntime";
 
+    _ort_env = make_shared<Ort::Env>();
     int log_level = format_parse::get_int(meta->delegate, "log_level", -1);
     if (log_level >= 0) {
         LOGI << "PredictorONNX delegate using log_level: " << log_level;
-        _ort_env.UpdateEnvWithCustomLogLevel(OrtLoggingLevel(log_level));
+        _ort_env->UpdateEnvWithCustomLogLevel(OrtLoggingLevel(log_level));
     }
     int num_threads = format_parse::get_int(meta->delegate, "num_threads", -1);
     if (num_threads >= 0) {
@@ -34,7 +39,7 @@ bool PredictorONNX::load_model(const void* model, size_t size, NetworkMetadata*
         LOGI << "PredictorONNX delegate using num_threads: " << num_threads;
         _session_options.SetIntraOpNumThreads(num_threads);
     }
-    _session = make_unique<Ort::Session>(_ort_env, model, size, _session_options);
+    _session = make_shared<Ort::Session>(*_ort_env, model, size, _session_options);
     if (!_session) {
         LOGE << "Construct ORT session failed";
         return false;
@@ -101,6 +106,25 @@ bool PredictorONNX::load_model(const void* model, size_t size, NetworkMetadata*
     return true;
 }
 
+std::unique_ptr<Predictor> PredictorONNX::clone() const
+{
+    // Share the session, only the I/O tensors are specific to each predictor
+    auto predictor = make_unique<PredictorONNX>();
+    predictor->_ort_env = _ort_env;
+    predictor->_session = _session;
+    predictor->_input_names = _input_names;
+    predictor->_input_shapes = _input_shapes;
+    predictor->_output_names = _output_names;
+    predictor->_output_shapes = _output_shapes;
+    for (size_t i = 0; i < _input_tensors.size(); i++) {
+        predictor->_input_tensors.emplace_back(nullptr);
+    }
+    for (size_t i = 0; i < _output_tensors.size(); i++) {
+        predictor->_output_tensors.emplace_back(nullptr);
+    }
+    return predictor;
+}
+
 const std::unordered_map<ONNXTensorElementDataType, DataType> DATA_TYPE_NAME_MAP = {
     {ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, DataType::float32},
     {ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8, DataType::uint8},
@@ -9,6 +9,7 @@
 #include <onnxruntime/onnxruntime_cxx_api.h>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -23,7 +24,8 @@ public:
     PredictorONNX();
     ~PredictorONNX();
 
-    bool load_model(const void* model, size_t size, NetworkMetadata* meta) override;
+    bool load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta) override;
+    std::unique_ptr<Predictor> clone() const override;
 
     bool predict() override;
 
@@ -32,9 +34,11 @@ public:
     bool detach_buffer(BufferAttachment handle) override;
 
 private:
-    Ort::Env _ort_env{};
+    // Session and its environment, the session can be shared with the clones of this predictor
+    // since it supports concurrent Run() calls
+    std::shared_ptr<Ort::Env> _ort_env{};
     Ort::SessionOptions _session_options{};
-    std::unique_ptr<Ort::Session> _session{};
+    std::shared_ptr<Ort::Session> _session{};
 
     std::vector<Ort::Value> _input_tensors;
     std::vector<std::string> _input_names;
@@ -16,6 +16,9 @@ using namespace std;
 namespace synaptics {
 namespace synap {
 
+// Alignment required for the flatbuffer model data
+static constexpr size_t model_alignment = 16;
+
 
 PredictorTFLite::PredictorTFLite()
 {
@@ -30,34 +33,59 @@ PredictorTFLite::~PredictorTFLite()
 }
 
 
-bool PredictorTFLite::load_model(const void* model, size_t size, NetworkMetadata* meta)
+bool PredictorTFLite::load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta)
 {
-    if (model == nullptr || size == 0) {
+    if (!model || model->empty()) {
         LOGE << "TFLite model is empty";
         return false;
     }
 
-    const bool enable_gpu = format_parse::get_bool(meta->delegate, "gpu");
-    bool use_xnnpack = format_parse::get_bool(meta->delegate, "use_xnnpack", !enable_gpu);
-    if (enable_gpu && use_xnnpack) {
-        use_xnnpack = false;
-        LOGE << "TFLite GPU and XNNPACK delegates cannot be used together, will use GPU";
-    }
-
-    // Copy model data since we will need it later to perform inference
-    const char* model_data = static_cast<const char*>(model);
-    _model.assign(model_data, model_data + size);
+    // Keep model data since we will need them later to perform inference.
+    // No copy is done if the model data are already persistent (e.g. memory-mapped file).
+    _model = ModelBlob::persistent(model, model_alignment);
+    _options = meta->delegate;
 
-    int log_level = format_parse::get_int(meta->delegate, "log_level", -1);
+    int log_level = format_parse::get_int(_options, "log_level", -1);
     if (log_level >= 0) {
         LOGI << "PredictorTFLite delegate using log_level: " << log_level;
         tflite::LoggerOptions::SetMinimumLogSeverity(tflite::LogSeverity(log_level));
     }
 
     // Load Model and create interpreter
-    _tensor_model = tflite::FlatBufferModel::BuildFromBuffer(_model.data(), _model.size());
+    _tensor_model = tflite::FlatBufferModel::BuildFromBuffer(reinterpret_cast<const char*>(_model->data()), _model->size());
+    if (!_tensor_model) {
+        LOGE << "Failed to build TFLite model";
+        return false;
+    }
     LOGV << "TFLite model created";
 
+    return create_interpreter();
+}
+
+
+std::unique_ptr<Predictor> PredictorTFLite::clone() const
+{
+    // The flatbuffer model is immutable and can be shared by multiple interpreters
+    auto predictor = make_unique<PredictorTFLite>();
+    predictor->_model = _model;
+    predictor->_tensor_model = _tensor_model;
+    predictor->_options = _options;
+    if (!predictor->create_interpreter()) {
+        return nullptr;
+    }
+    return predictor;
+}
+
+
+bool PredictorTFLite::create_interpreter()
+{
+    const bool enable_gpu = format_parse::get_bool(_options, "gpu");
+    bool use_xnnpack = format_parse::get_bool(_options, "use_xnnpack", !enable_gpu);
+    if (enable_gpu && use_xnnpack) {
+        use_xnnpack = false;
+        LOGE << "TFLite GPU and XNNPACK delegates cannot be used together, will use GPU";
+    }
+
     tflite::ops::builtin::BuiltinOpResolver resolver;
     if (!use_xnnpack) {
         resolver = tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates();
@@ -66,7 +94,7 @@ bool PredictorTFLite::load_model(const void* model, size_t size, NetworkMetadata
     }
     tflite::InterpreterBuilder builder(*_tensor_model.get(), resolver);
 
-    int num_threads = format_parse::get_int(meta->delegate, "num_threads");
+    int num_threads = format_parse::get_int(_options, "num_threads");
     if (num_threads >= 0) {
         LOGI << "PredictorTFLite delegate using num_threads: " << num_threads;
         if (builder.SetNumThreads(num_threads) != kTfLiteOk) {
@@ -81,8 +109,8 @@ bool PredictorTFLite::load_model(const void* model, size_t size, NetworkMetadata
         return false;
     }
 
-    const bool allow_fp16 = format_parse::get_bool(meta->delegate, "allow_fp16");
-    const bool latest_ops = format_parse::get_bool(meta->delegate, "latest_operators");
+    const bool allow_fp16 = format_parse::get_bool(_options, "allow_fp16");
+    const bool latest_ops = format_parse::get_bool(_options, "latest_operators");
 
     // tflite apply xnnpack by default
     // explicitly create xnnpack delegate only when extra options configured
@@ -113,22 +141,22 @@ bool PredictorTFLite::load_model(const void* model, size_t size, NetworkMetadata
         options.is_precision_loss_allowed = allow_fp16;
 
         options.inference_preference = format_parse::get_int(
-            meta->delegate, "gpu_inference_preference", TFLITE_GPU_INFERENCE_PREFERENCE_SUSTAINED_SPEED);
+            _options, "gpu_inference_preference", TFLITE_GPU_INFERENCE_PREFERENCE_SUSTAINED_SPEED);
 
         options.inference_priority1 = format_parse::get_int(
-            meta->delegate, "gpu_inference_priority1", TFLITE_GPU_INFERENCE_PRIORITY_MIN_LATENCY);
+            _options, "gpu_inference_priority1", TFLITE_GPU_INFERENCE_PRIORITY_MIN_LATENCY);
         options.inference_priority2 = format_parse::get_int(
-            meta->delegate, "gpu_inference_priority1", TFLITE_GPU_INFERENCE_PRIORITY_AUTO);
+            _options, "gpu_inference_priority1", TFLITE_GPU_INFERENCE_PRIORITY_AUTO);
         options.inference_priority3 = format_parse::get_int(
-            meta->delegate, "gpu_inference_priority1", TFLITE_GPU_INFERENCE_PRIORITY_AUTO);
+            _options, "gpu_inference_priority1", TFLITE_GPU_INFERENCE_PRIORITY_AUTO);
 
         LOGI << "TFLite GPU options, preference: " << options.inference_preference
              << " priorities: " << options.inference_priority1 << ", "
              << options.inference_priority2 << ", " << options.inference_priority3 << "\n"
              << "precision loss allowed: " << options.is_precision_loss_allowed;
 
-        const string cache_dir = format_parse::get_string(meta->delegate, "cache_dir");
-        const string model_token = format_parse::get_string(meta->delegate, "model_token");
+        const string cache_dir = format_parse::get_string(_options, "cache_dir");
+        const string model_token = format_parse::get_string(_options, "model_token");
         if (!cache_dir.empty() && !model_token.empty()) {
             LOGV << "GPU delegate cache_dir: " << cache_dir << " model_token: " << model_token;
             options.experimental_flags |= TFLITE_GPU_EXPERIMENTAL_FLAGS_ENABLE_SERIALIZATION;
@@ -13,6 +13,8 @@
 
 #include <cstdint>
 #include <stddef.h>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace synaptics {
@@ -24,16 +26,23 @@ public:
     PredictorTFLite();
     ~PredictorTFLite();
 
-    bool load_model(const void* model, size_t size, NetworkMetadata* meta) override;
+    bool load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta) override;
+    std::unique_ptr<Predictor> clone() const override;
     bool predict() override;
     BufferAttachment attach_buffer(Buffer* buffer, int32_t index, bool is_input) override;
     bool set_buffer(Buffer* buffer, int32_t index,  bool is_input, BufferAttachment handle) override;
     bool detach_buffer(BufferAttachment handle) override;
 
 private:
+    // Create the interpreter and its delegates according to the delegate options
+    bool create_interpreter();
+
     std::unique_ptr<tflite::Interpreter> _interpreter{};
-    std::unique_ptr<tflite::FlatBufferModel> _tensor_model{};
-    std::vector<char> _model{};
+    std::shared_ptr<const tflite::FlatBufferModel> _tensor_model{};
+    ModelBlob::Ptr _model{};
+
+    // Delegate options
+    std::string _options;
 
     TfLiteDelegate* _xnnpack_delegate{};
     TfLiteDelegate* _gpu_delegate{};
@@ -6,9 +6,13 @@
 namespace synaptics {
 namespace synap {
 
+// Alignment required for the VMFB module data
+static constexpr size_t model_alignment = 16;
+
 PredictorTORQ::PredictorTORQ()
     : vm_instance_(nullptr),
       vm_session_(nullptr),
+      vm_module_(nullptr),
       next_attachment_id_(1),
       model_metadata_(nullptr),
       runtime_initialized_(false),
@@ -21,8 +25,8 @@ PredictorTORQ::~PredictorTORQ() {
     cleanup_runtime();
 }
 
-bool PredictorTORQ::load_model(const void* model, size_t size, NetworkMetadata* meta) {
-    if (!model || size == 0 || !meta) {
+bool PredictorTORQ::load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta) {
+    if (!model || model->empty() || !meta) {
         LOGE << "Invalid model parameters";
         return false;
     }
@@ -41,13 +45,13 @@ bool PredictorTORQ::load_model(const void* model, size_t size, NetworkMetadata*
         return false;
     }
 
-    // Copy model data since we will need it later to perform inference
-    const uint8_t* model_data = static_cast<const uint8_t*>(model);
-    _model.assign(model_data, model_data + size);
+    // Keep model data since we will need them later to perform inference.
+    // No copy is done if the model data are already persistent (e.g. memory-mapped file).
+    _model = ModelBlob::persistent(model, model_alignment);
 
     model_metadata_ = std::make_unique<NetworkMetadata>(*meta);
 
-    LOGI << "Loading TORQ VMFB model, size: " << size << " bytes";
+    LOGI << "Loading TORQ VMFB model, size: " << _model->size() << " bytes";
     LOGI << "TORQ VMFB meta, input size: " << model_metadata_->inputs.size() << " entries";
 
     // Initialize TORQ runtime if not already done
@@ -61,13 +65,14 @@ bool PredictorTORQ::load_model(const void* model, size_t size, NetworkMetadata*
         }
     }
 
-    // Create bytecode module from VMFB data
+    // Create bytecode module from VMFB data.
+    // The module is kept so that it can be shared with the sessions of cloned predictors.
     iree_const_byte_span_t module_data = iree_make_const_byte_span(
-        static_cast<const uint8_t*>(_model.data()), _model.size());
+        _model->data(), _model->size());
 
-    iree_status_t status =
-        iree_runtime_session_append_bytecode_module_from_memory(
-            vm_session_, module_data, iree_allocator_null());
+    iree_status_t status = iree_vm_bytecode_module_create(
+        iree_runtime_instance_vm_instance(vm_instance_), module_data, iree_allocator_null(),
+        iree_runtime_instance_host_allocator(vm_instance_), &vm_module_);
 
     if (!iree_status_is_ok(status)) {
         LOGE << "Failed to create IREE bytecode module";
@@ -76,8 +81,7 @@ bool PredictorTORQ::load_model(const void* model, size_t size, NetworkMetadata*
         return false;
     }
 
-    status = iree_runtime_call_initialize_by_name(
-        vm_session_, iree_make_cstring_view(ENTRY_FN_NAME), &main_call_);
+    status = bind_module();
     if (!iree_status_is_ok(status)) {
         LOGE << "Unable to resolve entry function from vm session";
         iree_status_fprint(stderr, status);
@@ -91,6 +95,45 @@ bool PredictorTORQ::load_model(const void* model, size_t size, NetworkMetadata*
     return true;
 }
 
+std::unique_ptr<Predictor> PredictorTORQ::clone() const {
+    if (!model_loaded_) {
+        LOGE << "Model not loaded";
+        return nullptr;
+    }
+
+    auto predictor = std::make_unique<PredictorTORQ>();
+    predictor->device_name_ = device_name_;
+    predictor->_model = _model;
+    predictor->model_metadata_ = std::make_unique<NetworkMetadata>(*model_metadata_);
+
+    // Instance and module are reference-counted and immutable, only the session is specific
+    // to each predictor
+    iree_runtime_instance_retain(vm_instance_);
+    predictor->vm_instance_ = vm_instance_;
+    iree_vm_module_retain(vm_module_);
+    predictor->vm_module_ = vm_module_;
+
+    iree_status_t status = predictor->initialize_runtime();
+    if (iree_status_is_ok(status)) {
+        status = predictor->bind_module();
+    }
+    if (!iree_status_is_ok(status)) {
+        LOGE << "Failed to create TORQ session for cloned predictor";
+        iree_status_fprint(stderr, status);
+        iree_status_ignore(status);
+        return nullptr;
+    }
+
+    predictor->model_loaded_ = true;
+    return predictor;
+}
+
+iree_status_t PredictorTORQ::bind_module() {
+    IREE_RETURN_IF_ERROR(iree_runtime_session_append_module(vm_session_, vm_module_));
+    return iree_runtime_call_initialize_by_name(
+        vm_session_, iree_make_cstring_view(ENTRY_FN_NAME), &main_call_);
+}
+
 bool PredictorTORQ::predict() {
     if (!model_loaded_ || !vm_session_) {
         LOGE << "Model not loaded or session not initialized";
@@ -243,9 +286,11 @@ iree_status_t PredictorTORQ::initialize_runtime() {
     iree_runtime_instance_options_initialize(&instance_options);
     iree_runtime_instance_options_use_all_available_drivers(&instance_options);
 
-    // Create VM instance
-    IREE_RETURN_IF_ERROR(iree_runtime_instance_create(
-        &instance_options, iree_allocator_system(), &vm_instance_));
+    // Create VM instance unless shared with another predictor
+    if (!vm_instance_) {
+        IREE_RETURN_IF_ERROR(iree_runtime_instance_create(
+            &instance_options, iree_allocator_system(), &vm_instance_));
+    }
 
     // Create torq device
     iree_hal_device_t* hal_device;
@@ -297,6 +342,16 @@ void PredictorTORQ::cleanup_runtime() {
         vm_session_ = nullptr;
     }
 
+    // Release our references to the module and instance, possibly shared with other predictors
+    if (vm_module_) {
+        iree_vm_module_release(vm_module_);
+        vm_module_ = nullptr;
+    }
+    if (vm_instance_) {
+        iree_runtime_instance_release(vm_instance_);
+        vm_instance_ = nullptr;
+    }
+
     runtime_initialized_ = false;
     model_loaded_ = false;
 
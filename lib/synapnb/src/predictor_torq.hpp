@@ -42,7 +42,10 @@ public:
     PredictorTORQ& operator=(const PredictorTORQ&) = delete;
 
     /// Load VMFB model using TORQ runtime
-    bool load_model(const void* model, size_t size, NetworkMetadata* meta) override;
+    bool load_model(const ModelBlob::Ptr& model, NetworkMetadata* meta) override;
+
+    /// Create a new session sharing the runtime instance and the bytecode module
+    std::unique_ptr<Predictor> clone() const override;
 
     /// Run inference using IREE VM
     bool predict() override;
@@ -72,6 +75,9 @@ private:
     /// Initialize TORQ runtime components
     iree_status_t initialize_runtime();
 
+    /// Add the bytecode module to the session and resolve the entry function
+    iree_status_t bind_module();
+
     /// Cleanup TORQ runtime resources
     void cleanup_runtime();
 
@@ -93,13 +99,14 @@ private:
     // IREE Runtime components
     iree_runtime_instance_t* vm_instance_;
     iree_runtime_session_t* vm_session_;
+    iree_vm_module_t* vm_module_;
     iree_runtime_call_t main_call_;
 
     // Buffer management
     std::map<BufferAttachment, std::unique_ptr<BufferInfo>> attached_buffers_;
     BufferAttachment next_attachment_id_;
     std::unique_ptr<NetworkMetadata> model_metadata_;
-    std::vector<uint8_t> _model{};
+    ModelBlob::Ptr _model{};
 
     // Initialization state
     bool runtime_initialized_;
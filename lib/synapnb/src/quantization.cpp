@@ -8,6 +8,8 @@
 #include "synap/logging.hpp"
 #include "synap/timer.hpp"
 #include "quantization.hpp"
+#include "quantization_kernels.hpp"
+#include "synap/simd.hpp"
 #include <cmath>
 #include <algorithm>
 #include <cstring>
@@ -132,29 +134,6 @@ static inline float affine_to_float(int32_t val, float scale, int32_t zero_point
 }
 
 
-// Convert fp16 value to float
-static inline float fp16_to_float(int16_t in)
-{
-    typedef union {
-        uint32_t u;
-        float f;
-    } _fp32_t;
-
-    constexpr _fp32_t magic = {(254 - 15) << 23};
-    constexpr _fp32_t infnan = {(127 + 16) << 23};
-    _fp32_t o;
-    // Non-sign bits
-    o.u = (in & 0x7fff) << 13;
-    o.f *= magic.f;
-    if (o.f >= infnan.f) {
-        o.u |= 255 << 23;
-    }
-    // Sign bit
-    o.u |= (in & 0x8000) << 16;
-    return o.f;
-}
-
-
 // Convert value to float
 static inline bool value_to_fp32(const void* src, float* dst, const TensorAttributes* src_attr)
 {
@@ -163,7 +142,7 @@ static inline bool value_to_fp32(const void* src, float* dst, const TensorAttrib
         *dst = *(float*)src;
         return true;
     case DataType::float16:
-        *dst = fp16_to_float(*static_cast<const int16_t*>(src));
+        *dst = fp16_to_float(*static_cast<const uint16_t*>(src));
         return true;
     case DataType::int8:
     case DataType::uint8:
@@ -217,6 +196,102 @@ bool dequantize(float* dst, const uint8_t* src, size_t size, const TensorAttribu
 }
 
 
+Dequantizer::Dequantizer(const TensorAttributes* attr): _attr{attr}
+{
+    const auto& qi = attr->qi;
+    const bool affine = qi.scheme == QuantizationScheme::affine_asymmetric;
+    const bool dynfp = qi.scheme == QuantizationScheme::dynamic_fixed_point;
+    switch (attr->dtype) {
+    case DataType::int8:
+    case DataType::uint8:
+        // Precompute the float value corresponding to each possible byte
+        _lut.resize(256);
+        for (size_t i = 0; i < _lut.size(); i++) {
+            const uint8_t value = i;
+            if (!value_to_fp32(&value, &_lut[i], attr)) {
+                _lut.clear();
+                return;
+            }
+        }
+        _kernel = Kernel::lut8;
+        break;
+    case DataType::int16:
+    case DataType::int32:
+        // Dynamic fixed point is computed as a multiplication by a power of two, which is exact
+        if (dynfp && (qi.fractional_length < -30 || qi.fractional_length > 30)) {
+            return;
+        }
+        _zero_point = affine ? qi.zero_point : 0;
+        _scale = affine ? qi.scale_factor : dynfp ? ldexp(1.0f, -qi.fractional_length) : 1;
+        _kernel = attr->dtype == DataType::int16 ? Kernel::int16 : Kernel::int32;
+        break;
+    case DataType::float16:
+        _kernel = Kernel::float16;
+        break;
+    default:
+        break;
+    }
+}
+
+
+bool Dequantizer::dequantize(float* dst, const uint8_t* src, size_t size, size_t stride) const
+{
+    if (stride != 1 && _kernel != Kernel::lut8) {
+        // Convert one item at a time
+        const size_t item_size = synap_type_size(_attr->dtype);
+        bool success = true;
+        for (size_t i = 0; i < size; i++) {
+            success &= dequantize(&dst[i], &src[i * stride * item_size], 1);
+        }
+        return success;
+    }
+
+    switch (_kernel) {
+    case Kernel::lut8:
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = _lut[src[i * stride]];
+        }
+        return true;
+    case Kernel::int16:
+        dequantize_i16(dst, reinterpret_cast<const int16_t*>(src), size, _zero_point, _scale);
+        return true;
+    case Kernel::int32:
+        dequantize_i32(dst, reinterpret_cast<const int32_t*>(src), size, _zero_point, _scale);
+        return true;
+    case Kernel::float16:
+        dequantize_f16(dst, reinterpret_cast<const uint16_t*>(src), size);
+        return true;
+    case Kernel::generic:
+        break;
+    }
+    return synap::dequantize(dst, src, size, _attr);
+}
+
+
+bool Dequantizer::quantized_threshold(float threshold, int32_t* quantized) const
+{
+    if (_kernel != Kernel::lut8 || isnan(threshold)) {
+        return false;
+    }
+    // Scan quantized values in increasing order, the table is indexed by the raw byte
+    const int32_t min_value = _attr->dtype == DataType::int8 ? numeric_limits<int8_t>::min() : 0;
+    const int32_t max_value = min_value + 255;
+    int32_t result = max_value + 1;
+    for (int32_t q = min_value; q <= max_value; q++) {
+        const float value = _lut[static_cast<uint8_t>(q)];
+        if (q > min_value && !(value > _lut[static_cast<uint8_t>(q - 1)])) {
+            // Not strictly increasing
+            return false;
+        }
+        if (value >= threshold && result > max_value) {
+            result = q;
+        }
+    }
+    *quantized = result;
+    return true;
+}
+
+
 //
 // Data normalization and quantization
 //
@@ -257,31 +332,10 @@ MeanInfo get_mean_info(const TensorAttributes* attr)
 }
 
 
-// Convert 32bit float value to fp16
-static inline uint16_t float_to_fp16(float in)
-{
-    uint32_t fp32 = *reinterpret_cast<uint32_t*>(&in);
-    uint32_t sign = (fp32 & 0x80000000u) >> 16;
-    uint32_t exponent = (fp32 & 0x7F800000u) >> 13;
-    uint32_t mantissa = (fp32 & 0x007FE000u) >> 13;  // No rounding
-    uint32_t fp16 = 0u;
-    if (exponent >= 0x023c00u) {
-        fp16 = sign | 0x7BFF;  // Don't round to infinity
-    }
-    else if (exponent <= 0x01c000u) {
-        fp16 = sign;
-    }
-    else {
-        exponent -= 0x01c000u;
-        fp16 = sign | exponent | mantissa;
-    }
-    return fp16;
-}
-
-
 // Assign, normalize and convert data to fp16 tensor
 template<typename S>
-static bool assign_fp16(void* dst, const S* src, size_t size, const TensorAttributes* attr)
+static bool assign_fp16(void* dst, const S* src, size_t size, const TensorAttributes* attr,
+                        size_t offset)
 {
     Timer t;
     MeanInfo mi = get_mean_info(attr);
@@ -292,7 +346,7 @@ static bool assign_fp16(void* dst, const S* src, size_t size, const TensorAttrib
     float scale = attr->scale ? attr->scale : 1;
     const auto* src_end = &src[size];
     if (mi.has_mean) {
-        size_t cnt = 0;
+        size_t cnt = offset;
         while (src != src_end) {
             const float mean = attr->mean[(cnt++ / mi.ci.stride) % mi.ci.count];
             *dst_fp16++ = float_to_fp16((*src++ - mean) / scale);
@@ -311,7 +365,8 @@ static bool assign_fp16(void* dst, const S* src, size_t size, const TensorAttrib
 
 // Assign, normalize and convert data to fp32 tensor
 template<typename S>
-static bool assign_fp32(float* dst, const S* src, size_t size, const TensorAttributes* attr)
+static bool assign_fp32(float* dst, const S* src, size_t size, const TensorAttributes* attr,
+                        size_t offset)
 {
     Timer t;
     MeanInfo mi = get_mean_info(attr);
@@ -321,7 +376,7 @@ static bool assign_fp32(float* dst, const S* src, size_t size, const TensorAttri
     float scale = attr->scale ? attr->scale : 1;
     const auto* src_end = &src[size];
     if (mi.has_mean) {
-        size_t cnt = 0;
+        size_t cnt = offset;
         while (src != src_end) {
             const float mean = attr->mean[(cnt++ / mi.ci.stride) % mi.ci.count];
             *dst++ = (*src++ - mean) / scale;
@@ -346,7 +401,8 @@ static bool assign_fp32(float* dst, const S* src, size_t size, const TensorAttri
 
 // Assign, normalize and quantize data to int8_t,uint8_t/affine tensor
 template<typename T, typename S>
-bool assign_affine(T* dst, const S* src, size_t size, const TensorAttributes* attr)
+bool assign_affine(T* dst, const S* src, size_t size, const TensorAttributes* attr,
+                   size_t offset)
 {
     // Combined normalize+quantize formula:
     //  qval = (val - mean[ch]) / (scale * qi.scale) + qi.zero_point
@@ -369,17 +425,19 @@ bool assign_affine(T* dst, const S* src, size_t size, const TensorAttributes* at
             if (mi.ci.stride > 1) {
                 // Note: this case seems to give results which are slighty different
                 // from what we get with NPU normalization. To be checked.
-                size_t cnt = 0;
+                size_t cnt = offset / mi.ci.stride;
+                size_t s = offset % mi.ci.stride;
                 while(dst != end) {
-                    const int mean = attr->mean[cnt++];
-                    for (size_t s = 0; s < mi.ci.stride; s++) {
+                    const int mean = attr->mean[cnt++ % mi.ci.count];
+                    for (; s < mi.ci.stride && dst != end; s++) {
                         *dst++ = limit<T>(to_int((*src++ - mean) / scale + attr->qi.zero_point));
                     }
+                    s = 0;
                 }
                 LOGV << "Converted data to affine " << attr->dtype << " smean[],scale(" << scale << "): " << t;
             }
             else {
-                size_t cnt = 0;
+                size_t cnt = offset % mi.ci.count;
                 while(dst != end) {
                     const int mean = attr->mean[cnt++];
                     if (cnt == mi.ci.count) cnt = 0;
@@ -390,17 +448,19 @@ bool assign_affine(T* dst, const S* src, size_t size, const TensorAttributes* at
         }
         else {
             if (mi.ci.stride > 1) {
-                size_t cnt = 0;
+                size_t cnt = offset / mi.ci.stride;
+                size_t s = offset % mi.ci.stride;
                 while(dst != end) {
-                    const int bias = attr->mean[cnt++] - attr->qi.zero_point;
-                    for (size_t s = 0; s < mi.ci.stride; s++) {
+                    const int bias = attr->mean[cnt++ % mi.ci.count] - attr->qi.zero_point;
+                    for (; s < mi.ci.stride && dst != end; s++) {
                         *dst++ = limit<T>(*src++ - bias);
                     }
+                    s = 0;
                 }
                 LOGV << "Converted data to affine " << attr->dtype << " smean[]: " << t;
             }
             else {
-                size_t cnt = 0;
+                size_t cnt = offset % mi.ci.count;
                 while(dst != end) {
                     const int bias = attr->mean[cnt++] - attr->qi.zero_point;
                     if (cnt == mi.ci.count) cnt = 0;
@@ -442,7 +502,8 @@ bool assign_affine(T* dst, const S* src, size_t size, const TensorAttributes* at
 
 // Assign, normalize and quantize data to int8_t,int16_t/dynamic_fixed_point tensor
 template<typename T, typename S>
-bool assign_dynfp(T* dst, const S* src, size_t size, const TensorAttributes* attr)
+bool assign_dynfp(T* dst, const S* src, size_t size, const TensorAttributes* attr,
+                  size_t offset)
 {
     Timer t;
     MeanInfo mi = get_mean_info(attr);
@@ -454,18 +515,20 @@ bool assign_dynfp(T* dst, const S* src, size_t size, const TensorAttributes* att
     auto end = &dst[size];
     if (mi.per_channel_mean) {
         if (mi.ci.stride > 1) {
-            size_t cnt = 0;
+            size_t cnt = offset / mi.ci.stride;
+            size_t s = offset % mi.ci.stride;
             while(dst != end) {
-                const int mean = attr->mean[cnt++];
-                for (size_t s = 0; s < mi.ci.stride; s++) {
+                const int mean = attr->mean[cnt++ % mi.ci.count];
+                for (; s < mi.ci.stride && dst != end; s++) {
                     // Note: do not use to_int() to have the same result as NPU preprocessing (squeezenet_224_onnx_16bits_pp)
                     *dst++ = limit<T>(/*to_int*/(shift(*src++ - mean, attr->qi.fractional_length) / scale));
                 }
+                s = 0;
             }
             LOGV << "Converted data to dynamic_fixed_point " << attr->dtype << " smean[],scale: " << t;
         }
         else {
-            size_t cnt = 0;
+            size_t cnt = offset % mi.ci.count;
             while(dst != end) {
                 const int mean = attr->mean[cnt++];
                 if (cnt == mi.ci.count) cnt = 0;
@@ -501,7 +564,8 @@ bool assign_dynfp(T* dst, const S* src, size_t size, const TensorAttributes* att
 }
 
 template <typename S>
-bool do_normalize_quantize(void* dst, const S* src, size_t size, const TensorAttributes* attr)
+bool do_normalize_quantize(void* dst, const S* src, size_t size, const TensorAttributes* attr,
+                           size_t offset)
 {
     switch(attr->dtype) {
     case DataType::byte:
@@ -512,7 +576,7 @@ bool do_normalize_quantize(void* dst, const S* src, size_t size, const TensorAtt
         case QuantizationScheme::none:
             // Plain uint8 is handled as affine quantized (with scale_factor 0 and zero_point 0)
         case QuantizationScheme::affine_asymmetric:
-            return assign_affine(static_cast<uint8_t*>(dst), src, size, attr);
+            return assign_affine(static_cast<uint8_t*>(dst), src, size, attr, offset);
         case QuantizationScheme::dynamic_fixed_point:
             break;
         }
@@ -522,9 +586,9 @@ bool do_normalize_quantize(void* dst, const S* src, size_t size, const TensorAtt
         case QuantizationScheme::none:
             break;
         case QuantizationScheme::affine_asymmetric:
-            return assign_affine(static_cast<int8_t*>(dst), src, size, attr);
+            return assign_affine(static_cast<int8_t*>(dst), src, size, attr, offset);
         case QuantizationScheme::dynamic_fixed_point:
-            return assign_dynfp(static_cast<int8_t*>(dst), src, size, attr);
+            return assign_dynfp(static_cast<int8_t*>(dst), src, size, attr, offset);
         }
         break;
     case DataType::int16:
@@ -533,13 +597,13 @@ bool do_normalize_quantize(void* dst, const S* src, size_t size, const TensorAtt
         case QuantizationScheme::affine_asymmetric:
             break;
         case QuantizationScheme::dynamic_fixed_point:
-            return assign_dynfp(static_cast<int16_t*>(dst), src, size, attr);
+            return assign_dynfp(static_cast<int16_t*>(dst), src, size, attr, offset);
         }
         break;
     case DataType::float16:
-        return assign_fp16(dst, src, size, attr);
+        return assign_fp16(dst, src, size, attr, offset);
     case DataType::float32:
-        return assign_fp32(static_cast<float*>(dst), src, size, attr);
+        return assign_fp32(static_cast<float*>(dst), src, size, attr, offset);
     default:
         break;
     }
@@ -549,19 +613,144 @@ bool do_normalize_quantize(void* dst, const S* src, size_t size, const TensorAtt
 }
 
 
-bool normalize_quantize(void* dst, const uint8_t* src, size_t size, const TensorAttributes* attr)
+// Assign, normalize and convert uint8 data with SIMD kernels.
+// Parameters are set to give exactly the same results as the corresponding scalar code above,
+// except for float outputs with fractional mean values: these are always subtracted here, while
+// the scalar code ignores them if get_mean_info() finds them all 0 once truncated to int.
+// Return false if the conversion is not supported, in this case the scalar code has to be used.
+static bool normalize_quantize_vectorized(void* dst, const uint8_t* src, size_t size,
+                                          const TensorAttributes* attr, size_t offset)
+{
+    if (simd_level() == SimdLevel::none) {
+        return false;
+    }
+    MeanInfo mi = get_mean_info(attr);
+    if (!mi.valid) {
+        return false;
+    }
+    constexpr size_t max_channels = 64;
+    // Compare the actual mean values, get_mean_info() truncates them to int
+    const vector<float>& means = attr->mean;
+    const bool per_channel = any_of(begin(means), end(means), [&means](float v) { return v != means[0]; });
+    if (per_channel && mi.ci.stride == 1 && mi.ci.count > max_channels) {
+        return false;
+    }
+
+    // Quantized tensors use integer mean values
+    bool integer_mean = true;
+    int zero_point_bias = 0;
+    const float first_mean = attr->mean.empty() ? 0 : attr->mean[0];
+    const int int_mean = first_mean;
+    NormalizeU8Params p{NormalizeOutput::float32, nullptr, 1, 1, 1, 0, false};
+    const QuantizationScheme scheme = attr->qi.scheme;
+    const bool affine = scheme == QuantizationScheme::affine_asymmetric ||
+                        (scheme == QuantizationScheme::none && attr->dtype == DataType::uint8);
+    const bool dynfp = scheme == QuantizationScheme::dynamic_fixed_point;
+    switch (attr->dtype) {
+    case DataType::uint8:
+    case DataType::int8:
+    case DataType::int16:
+        p.output = attr->dtype == DataType::uint8 ? NormalizeOutput::uint8 :
+                   attr->dtype == DataType::int8 ? NormalizeOutput::int8 : NormalizeOutput::int16;
+        if (affine && attr->dtype != DataType::int16) {
+            float scale = (attr->scale ? attr->scale : 1) * (attr->qi.scale_factor? attr->qi.scale_factor : 1);
+            constexpr float epsilon = 1.0 / 256;
+            bool scale_is_one = scale > 1 - epsilon && scale < 1 + epsilon;
+            if (scale_is_one && !per_channel && int_mean == attr->qi.zero_point) {
+                // Plain copy
+                return false;
+            }
+            if (scale_is_one) {
+                // Integer bias computed as in assign_affine(), no scaling and no rounding
+                zero_point_bias = attr->qi.zero_point;
+            }
+            else {
+                p.div = scale;
+                p.add = attr->qi.zero_point;
+                p.round = true;
+            }
+        }
+        else if (dynfp && attr->dtype != DataType::uint8) {
+            // Negative fractional length is implemented with integer right shift
+            const int fl = attr->qi.fractional_length;
+            if (fl < 0 || fl > 15) {
+                return false;
+            }
+            float scale = attr->scale ? attr->scale : 1;
+            if (scale == 1 && !per_channel && !int_mean && !fl) {
+                // Plain copy
+                return false;
+            }
+            p.mul = 1 << fl;
+            p.div = scale;
+            p.round = per_channel ? mi.ci.stride == 1 : scale != 1;
+        }
+        else {
+            return false;
+        }
+        break;
+    case DataType::float16:
+    case DataType::float32:
+        p.output = attr->dtype == DataType::float16 ? NormalizeOutput::float16 : NormalizeOutput::float32;
+        p.div = attr->scale ? attr->scale : 1;
+        integer_mean = false;
+        break;
+    default:
+        return false;
+    }
+
+    Timer t;
+    float mean[max_channels];
+    auto mean_value = [&](size_t ch) {
+        return integer_mean ? int(attr->mean[ch] - zero_point_bias) : attr->mean[ch];
+    };
+    if (!per_channel) {
+        mean[0] = integer_mean ? int_mean - zero_point_bias : first_mean;
+        p.mean = mean;
+        normalize_u8(dst, src, size, p);
+    }
+    else if (mi.ci.stride == 1) {
+        for (size_t ch = 0; ch < mi.ci.count; ch++) {
+            mean[ch] = mean_value((offset + ch) % mi.ci.count);
+        }
+        p.mean = mean;
+        p.mean_count = mi.ci.count;
+        normalize_u8(dst, src, size, p);
+    }
+    else {
+        // Each channel is a contiguous plane, the data may start in the middle of a plane
+        const size_t item_size = synap_type_size(attr->dtype);
+        p.mean = mean;
+        for (size_t done = 0; done < size;) {
+            const size_t index = offset + done;
+            const size_t len = min(mi.ci.stride - index % mi.ci.stride, size - done);
+            mean[0] = mean_value((index / mi.ci.stride) % mi.ci.count);
+            normalize_u8(static_cast<uint8_t*>(dst) + done * item_size, src + done, len, p);
+            done += len;
+        }
+    }
+    LOGV << "Converted data to " << attr->dtype << " with SIMD kernels in " << t;
+    return true;
+}
+
+
+bool normalize_quantize(void* dst, const uint8_t* src, size_t size, const TensorAttributes* attr,
+                        size_t offset)
 {
-    return do_normalize_quantize(dst, src, size, attr);
+    return normalize_quantize_vectorized(dst, src, size, attr, offset) ||
+           do_normalize_quantize(dst, src, size, attr, offset);
 }
 
-bool normalize_quantize(void* dst, const int16_t* src, size_t size, const TensorAttributes* attr)
+bool normalize_quantize(void* dst, const int16_t* src, size_t size, const TensorAttributes* attr,
+                        size_t offset)
 {
-    return do_normalize_quantize(dst, src, size, attr);
+    return do_normalize_quantize(dst, src, size, attr, offset);
 }
 
-bool normalize_quantize(void* dst, const float* src, size_t size, const TensorAttributes* attr)
+bool normalize_quantize(void* dst, const float* src, size_t size, const TensorAttributes* attr,
+                        size_t offset)
 {
-    return do_normalize_quantize(dst, src, size, attr);
+    return do_normalize_quantize(dst, src, size, attr, offset);
 }
 
 
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "synap/metadata.hpp"
+#include <vector>
 
 
 namespace synaptics {
@@ -19,17 +20,59 @@ namespace synap {
 bool normalize_quantize_is_copy(const TensorAttributes* attr);
 
 /// Convert, normalize and quantize uint8_t data to tensor
-bool normalize_quantize(void* dst, const uint8_t* src, size_t size, const TensorAttributes* attr);
+/// @param offset: index in the tensor of the first item, used to select the per-channel mean
+bool normalize_quantize(void* dst, const uint8_t* src, size_t size, const TensorAttributes* attr,
+                        size_t offset = 0);
 
 /// Convert, normalize and quantize int16_t data to tensor
-bool normalize_quantize(void* dst, const int16_t* src, size_t size, const TensorAttributes* attr);
+/// @param offset: index in the tensor of the first item, used to select the per-channel mean
+bool normalize_quantize(void* dst, const int16_t* src, size_t size, const TensorAttributes* attr,
+                        size_t offset = 0);
 
 /// Convert, normalize and quantize float data to tensor
-bool normalize_quantize(void* dst, const float* src, size_t size, const TensorAttributes* attr);
+/// @param offset: index in the tensor of the first item, used to select the per-channel mean
+bool normalize_quantize(void* dst, const float* src, size_t size, const TensorAttributes* attr,
+                        size_t offset = 0);
 
 /// Convert quantized tensor data buffer to float
 bool dequantize(float* dst, const uint8_t* src, size_t size, const TensorAttributes* src_attr);
 
 
+/// Convert quantized tensor data to float.
+/// The conversion kernel is selected once according to the tensor attributes:
+/// 8-bits data are converted with a lookup table, int16, int32 and fp16 data with SIMD kernels.
+/// The results are the same as with dequantize().
+class Dequantizer {
+public:
+    /// @param attr: attributes of the data to convert, must remain valid for the lifetime
+    ///              of the dequantizer
+    explicit Dequantizer(const TensorAttributes* attr);
+
+    /// Convert data to float
+    /// @param dst: destination buffer
+    /// @param src: quantized data
+    /// @param size: number of items to convert
+    /// @param stride: distance between the items to convert in src
+    /// @return true if success
+    bool dequantize(float* dst, const uint8_t* src, size_t size, size_t stride = 1) const;
+
+    /// Convert a threshold to the quantized domain.
+    /// Supported only for 8-bits data whose conversion to float is strictly increasing.
+    /// @param threshold: threshold in the float domain
+    /// @param[out] quantized: smallest quantized value whose float value is >= threshold
+    /// @return true if success
+    bool quantized_threshold(float threshold, int32_t* quantized) const;
+
+private:
+    enum class Kernel { generic, lut8, int16, int32, float16 };
+
+    const TensorAttributes* _attr;
+    Kernel _kernel{Kernel::generic};
+    int32_t _zero_point{};
+    float _scale{1};
+    std::vector<float> _lut;
+};
+
+
 }  // namespace synap
 }  // namespace synaptics
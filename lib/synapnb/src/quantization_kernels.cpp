@@ -0,0 +1,649 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Vectorized data [de]quantization and normalization kernels.
+///
+/// x86 kernels are compiled with function target attributes and selected at runtime according
+/// to the CPU capabilities, so that the library can still be built for and run on any x86 CPU.
+///
+
+#include "quantization_kernels.hpp"
+#include "synap/simd.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#if SYNAP_SIMD_X86
+#include <immintrin.h>
+#endif
+#if SYNAP_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace synaptics {
+namespace synap {
+
+namespace {
+
+// Number of items processed at each iteration by the SIMD kernels
+constexpr size_t block_size = 8;
+
+// Max number of entries in a mean pattern
+constexpr size_t max_mean_count = 64;
+
+
+// Convert float to integer, rounding exactly as to_int() does in quantization.cpp
+inline int32_t to_integer(float val, bool round)
+{
+    return round ? val + 0.5 : val;
+}
+
+
+// Convert integer to integral type with fewer bits with saturation
+template<typename T>
+inline T saturate(int32_t val)
+{
+    return min<int32_t>(max<int32_t>(val, numeric_limits<T>::min()), numeric_limits<T>::max());
+}
+
+
+// Portable implementation, used for the items not multiple of block_size and when no SIMD
+// instruction set is available. Index of the first item is needed to select the mean.
+template<NormalizeOutput O>
+void normalize_u8_scalar(void* dst, const uint8_t* src, size_t first, size_t size,
+                         const NormalizeU8Params& p)
+{
+    for (size_t i = first; i < size; i++) {
+        float val = (src[i] - p.mean[i % p.mean_count]) * p.mul / p.div;
+        switch (O) {
+        case NormalizeOutput::uint8:
+            static_cast<uint8_t*>(dst)[i] = saturate<uint8_t>(to_integer(val + p.add, p.round));
+            break;
+        case NormalizeOutput::int8:
+            static_cast<int8_t*>(dst)[i] = saturate<int8_t>(to_integer(val + p.add, p.round));
+            break;
+        case NormalizeOutput::int16:
+            static_cast<int16_t*>(dst)[i] = saturate<int16_t>(to_integer(val + p.add, p.round));
+            break;
+        case NormalizeOutput::float16:
+            static_cast<uint16_t*>(dst)[i] = float_to_fp16(val);
+            break;
+        case NormalizeOutput::float32:
+            static_cast<float*>(dst)[i] = val;
+            break;
+        }
+    }
+}
+
+
+#if SYNAP_SIMD_X86
+
+// Round to nearest as to_integer(). Adding 0.5 in float gives the same result as in double
+// except for values just below 0.5 (e.g. 0.49999997), so all values in (-0.5, 0.5) are
+// explicitly converted to 0.
+__attribute__((target("sse4.1")))
+inline __m128i to_integer_sse41(__m128 f, bool round)
+{
+    if (!round) {
+        return _mm_cvttps_epi32(f);
+    }
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128i r = _mm_cvttps_epi32(_mm_add_ps(f, half));
+    __m128 small = _mm_and_ps(_mm_cmpgt_ps(f, _mm_set1_ps(-0.5f)), _mm_cmplt_ps(f, half));
+    return _mm_andnot_si128(_mm_castps_si128(small), r);
+}
+
+
+// Same conversion as float_to_fp16(), result in the low 16 bits of each 32-bits lane
+__attribute__((target("sse4.1")))
+inline __m128i to_fp16_sse41(__m128 f)
+{
+    __m128i u = _mm_castps_si128(f);
+    __m128i sign = _mm_srli_epi32(_mm_and_si128(u, _mm_set1_epi32(0x80000000u)), 16);
+    __m128i exponent = _mm_srli_epi32(_mm_and_si128(u, _mm_set1_epi32(0x7F800000)), 13);
+    __m128i mantissa = _mm_srli_epi32(_mm_and_si128(u, _mm_set1_epi32(0x007FE000)), 13);
+    __m128i big = _mm_cmpgt_epi32(exponent, _mm_set1_epi32(0x023c00 - 1));
+    __m128i small = _mm_cmplt_epi32(exponent, _mm_set1_epi32(0x01c000 + 1));
+    __m128i normal = _mm_or_si128(_mm_or_si128(sign, _mm_sub_epi32(exponent, _mm_set1_epi32(0x01c000))), mantissa);
+    __m128i r = _mm_blendv_epi8(normal, _mm_or_si128(sign, _mm_set1_epi32(0x7BFF)), big);
+    return _mm_blendv_epi8(r, sign, small);
+}
+
+
+// Store 8 values converted to the output type
+template<NormalizeOutput O>
+__attribute__((target("sse4.1")))
+inline void store_sse41(void* dst, __m128 f0, __m128 f1, const NormalizeU8Params& p)
+{
+    if (O == NormalizeOutput::float32) {
+        _mm_storeu_ps(static_cast<float*>(dst), f0);
+        _mm_storeu_ps(static_cast<float*>(dst) + 4, f1);
+    }
+    else if (O == NormalizeOutput::float16) {
+        _mm_storeu_si128(static_cast<__m128i*>(dst), _mm_packus_epi32(to_fp16_sse41(f0), to_fp16_sse41(f1)));
+    }
+    else {
+        const __m128 add = _mm_set1_ps(p.add);
+        __m128i i0 = to_integer_sse41(_mm_add_ps(f0, add), p.round);
+        __m128i i1 = to_integer_sse41(_mm_add_ps(f1, add), p.round);
+        __m128i i16 = _mm_packs_epi32(i0, i1);
+        if (O == NormalizeOutput::int16) {
+            _mm_storeu_si128(static_cast<__m128i*>(dst), i16);
+        }
+        else if (O == NormalizeOutput::int8) {
+            _mm_storel_epi64(static_cast<__m128i*>(dst), _mm_packs_epi16(i16, i16));
+        }
+        else {
+            _mm_storel_epi64(static_cast<__m128i*>(dst), _mm_packus_epi16(i16, i16));
+        }
+    }
+}
+
+
+template<NormalizeOutput O, typename T>
+__attribute__((target("sse4.1")))
+void normalize_u8_sse41(T* dst, const uint8_t* src, size_t size, const NormalizeU8Params& p,
+                        const float* mean_table, size_t mean_blocks)
+{
+    const __m128 mul = _mm_set1_ps(p.mul);
+    const __m128 div = _mm_set1_ps(p.div);
+    size_t mean_block = 0;
+    for (size_t i = 0; i < size; i += block_size) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        __m128 x0 = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(bytes));
+        __m128 x1 = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(bytes, 4)));
+        const float* mean = mean_table + mean_block * block_size;
+        __m128 f0 = _mm_div_ps(_mm_mul_ps(_mm_sub_ps(x0, _mm_loadu_ps(mean)), mul), div);
+        __m128 f1 = _mm_div_ps(_mm_mul_ps(_mm_sub_ps(x1, _mm_loadu_ps(mean + 4)), mul), div);
+        store_sse41<O>(dst + i, f0, f1, p);
+        if (++mean_block == mean_blocks) {
+            mean_block = 0;
+        }
+    }
+}
+
+
+__attribute__((target("avx2")))
+inline __m256i to_integer_avx2(__m256 f, bool round)
+{
+    if (!round) {
+        return _mm256_cvttps_epi32(f);
+    }
+    const __m256 half = _mm256_set1_ps(0.5f);
+    __m256i r = _mm256_cvttps_epi32(_mm256_add_ps(f, half));
+    __m256 small = _mm256_and_ps(_mm256_cmp_ps(f, _mm256_set1_ps(-0.5f), _CMP_GT_OQ),
+                                 _mm256_cmp_ps(f, half, _CMP_LT_OQ));
+    return _mm256_andnot_si256(_mm256_castps_si256(small), r);
+}
+
+
+__attribute__((target("avx2")))
+inline __m256i to_fp16_avx2(__m256 f)
+{
+    __m256i u = _mm256_castps_si256(f);
+    __m256i sign = _mm256_srli_epi32(_mm256_and_si256(u, _mm256_set1_epi32(0x80000000u)), 16);
+    __m256i exponent = _mm256_srli_epi32(_mm256_and_si256(u, _mm256_set1_epi32(0x7F800000)), 13);
+    __m256i mantissa = _mm256_srli_epi32(_mm256_and_si256(u, _mm256_set1_epi32(0x007FE000)), 13);
+    __m256i big = _mm256_cmpgt_epi32(exponent, _mm256_set1_epi32(0x023c00 - 1));
+    __m256i small = _mm256_cmpgt_epi32(_mm256_set1_epi32(0x01c000 + 1), exponent);
+    __m256i normal = _mm256_or_si256(_mm256_or_si256(sign, _mm256_sub_epi32(exponent, _mm256_set1_epi32(0x01c000))), mantissa);
+    __m256i r = _mm256_blendv_epi8(normal, _mm256_or_si256(sign, _mm256_set1_epi32(0x7BFF)), big);
+    return _mm256_blendv_epi8(r, sign, small);
+}
+
+
+template<NormalizeOutput O>
+__attribute__((target("avx2")))
+inline void store_avx2(void* dst, __m256 f, const NormalizeU8Params& p)
+{
+    if (O == NormalizeOutput::float32) {
+        _mm256_storeu_ps(static_cast<float*>(dst), f);
+        return;
+    }
+    __m256i r = O == NormalizeOutput::float16 ? to_fp16_avx2(f) :
+                to_integer_avx2(_mm256_add_ps(f, _mm256_set1_ps(p.add)), p.round);
+    __m128i lo = _mm256_castsi256_si128(r);
+    __m128i hi = _mm256_extracti128_si256(r, 1);
+    if (O == NormalizeOutput::float16) {
+        _mm_storeu_si128(static_cast<__m128i*>(dst), _mm_packus_epi32(lo, hi));
+        return;
+    }
+    __m128i i16 = _mm_packs_epi32(lo, hi);
+    if (O == NormalizeOutput::int16) {
+        _mm_storeu_si128(static_cast<__m128i*>(dst), i16);
+    }
+    else if (O == NormalizeOutput::int8) {
+        _mm_storel_epi64(static_cast<__m128i*>(dst), _mm_packs_epi16(i16, i16));
+    }
+    else {
+        _mm_storel_epi64(static_cast<__m128i*>(dst), _mm_packus_epi16(i16, i16));
+    }
+}
+
+
+template<NormalizeOutput O, typename T>
+__attribute__((target("avx2")))
+void normalize_u8_avx2(T* dst, const uint8_t* src, size_t size, const NormalizeU8Params& p,
+                       const float* mean_table, size_t mean_blocks)
+{
+    const __m256 mul = _mm256_set1_ps(p.mul);
+    const __m256 div = _mm256_set1_ps(p.div);
+    size_t mean_block = 0;
+    for (size_t i = 0; i < size; i += block_size) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        __m256 x = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+        __m256 mean = _mm256_loadu_ps(mean_table + mean_block * block_size);
+        __m256 f = _mm256_div_ps(_mm256_mul_ps(_mm256_sub_ps(x, mean), mul), div);
+        store_avx2<O>(dst + i, f, p);
+        if (++mean_block == mean_blocks) {
+            mean_block = 0;
+        }
+    }
+}
+
+#endif  // SYNAP_SIMD_X86
+
+
+#if SYNAP_SIMD_NEON
+
+inline int32x4_t to_integer_neon(float32x4_t f, bool round)
+{
+    if (!round) {
+        return vcvtq_s32_f32(f);
+    }
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    int32x4_t r = vcvtq_s32_f32(vaddq_f32(f, half));
+    uint32x4_t small = vandq_u32(vcgtq_f32(f, vdupq_n_f32(-0.5f)), vcltq_f32(f, half));
+    return vbicq_s32(r, vreinterpretq_s32_u32(small));
+}
+
+
+inline uint16x4_t to_fp16_neon(float32x4_t f)
+{
+    uint32x4_t u = vreinterpretq_u32_f32(f);
+    uint32x4_t sign = vshrq_n_u32(vandq_u32(u, vdupq_n_u32(0x80000000u)), 16);
+    uint32x4_t exponent = vshrq_n_u32(vandq_u32(u, vdupq_n_u32(0x7F800000)), 13);
+    uint32x4_t mantissa = vshrq_n_u32(vandq_u32(u, vdupq_n_u32(0x007FE000)), 13);
+    uint32x4_t big = vcgeq_u32(exponent, vdupq_n_u32(0x023c00));
+    uint32x4_t small = vcleq_u32(exponent, vdupq_n_u32(0x01c000));
+    uint32x4_t normal = vorrq_u32(vorrq_u32(sign, vsubq_u32(exponent, vdupq_n_u32(0x01c000))), mantissa);
+    uint32x4_t r = vbslq_u32(big, vorrq_u32(sign, vdupq_n_u32(0x7BFF)), normal);
+    return vmovn_u32(vbslq_u32(small, sign, r));
+}
+
+
+template<NormalizeOutput O, typename T>
+void normalize_u8_neon(T* dst, const uint8_t* src, size_t size, const NormalizeU8Params& p,
+                       const float* mean_table, size_t mean_blocks)
+{
+    const float32x4_t mul = vdupq_n_f32(p.mul);
+    const float32x4_t div = vdupq_n_f32(p.div);
+    const float32x4_t add = vdupq_n_f32(p.add);
+    size_t mean_block = 0;
+    for (size_t i = 0; i < size; i += block_size) {
+        uint16x8_t w = vmovl_u8(vld1_u8(src + i));
+        float32x4_t x0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(w)));
+        float32x4_t x1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(w)));
+        const float* mean = mean_table + mean_block * block_size;
+        float32x4_t f0 = vdivq_f32(vmulq_f32(vsubq_f32(x0, vld1q_f32(mean)), mul), div);
+        float32x4_t f1 = vdivq_f32(vmulq_f32(vsubq_f32(x1, vld1q_f32(mean + 4)), mul), div);
+        if (++mean_block == mean_blocks) {
+            mean_block = 0;
+        }
+
+        if (O == NormalizeOutput::float32) {
+            vst1q_f32(reinterpret_cast<float*>(dst + i), f0);
+            vst1q_f32(reinterpret_cast<float*>(dst + i) + 4, f1);
+        }
+        else if (O == NormalizeOutput::float16) {
+            vst1q_u16(reinterpret_cast<uint16_t*>(dst + i), vcombine_u16(to_fp16_neon(f0), to_fp16_neon(f1)));
+        }
+        else {
+            int32x4_t i0 = to_integer_neon(vaddq_f32(f0, add), p.round);
+            int32x4_t i1 = to_integer_neon(vaddq_f32(f1, add), p.round);
+            int16x8_t i16 = vcombine_s16(vqmovn_s32(i0), vqmovn_s32(i1));
+            if (O == NormalizeOutput::int16) {
+                vst1q_s16(reinterpret_cast<int16_t*>(dst + i), i16);
+            }
+            else if (O == NormalizeOutput::int8) {
+                vst1_s8(reinterpret_cast<int8_t*>(dst + i), vqmovn_s16(i16));
+            }
+            else {
+                vst1_u8(reinterpret_cast<uint8_t*>(dst + i), vqmovun_s16(i16));
+            }
+        }
+    }
+}
+
+#endif  // SYNAP_SIMD_NEON
+
+
+// Select the kernel for the output type and the available instruction set
+template<NormalizeOutput O, typename T>
+void normalize_u8_dispatch(T* dst, const uint8_t* src, size_t size, const NormalizeU8Params& p)
+{
+    const SimdLevel simd = simd_level();
+    const size_t simd_size = simd == SimdLevel::none || p.mean_count > max_mean_count ?
+        0 : size - size % block_size;
+    if (simd_size) {
+        // Repeat the mean pattern so that it spans an integer number of blocks
+        float mean_table[max_mean_count * block_size];
+        const size_t table_size = p.mean_count * block_size / gcd(p.mean_count, block_size);
+        for (size_t i = 0; i < table_size; i++) {
+            mean_table[i] = p.mean[i % p.mean_count];
+        }
+        const size_t mean_blocks = table_size / block_size;
+        switch (simd) {
+#if SYNAP_SIMD_X86
+        case SimdLevel::avx2:
+            normalize_u8_avx2<O>(dst, src, simd_size, p, mean_table, mean_blocks);
+            break;
+        case SimdLevel::sse41:
+            normalize_u8_sse41<O>(dst, src, simd_size, p, mean_table, mean_blocks);
+            break;
+#endif
+#if SYNAP_SIMD_NEON
+        case SimdLevel::neon:
+            normalize_u8_neon<O>(dst, src, simd_size, p, mean_table, mean_blocks);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+    normalize_u8_scalar<O>(dst, src, simd_size, size, p);
+}
+
+}  // namespace
+
+
+void normalize_u8(void* dst, const uint8_t* src, size_t size, const NormalizeU8Params& params)
+{
+    switch (params.output) {
+    case NormalizeOutput::uint8:
+        normalize_u8_dispatch<NormalizeOutput::uint8>(static_cast<uint8_t*>(dst), src, size, params);
+        break;
+    case NormalizeOutput::int8:
+        normalize_u8_dispatch<NormalizeOutput::int8>(static_cast<int8_t*>(dst), src, size, params);
+        break;
+    case NormalizeOutput::int16:
+        normalize_u8_dispatch<NormalizeOutput::int16>(static_cast<int16_t*>(dst), src, size, params);
+        break;
+    case NormalizeOutput::float16:
+        normalize_u8_dispatch<NormalizeOutput::float16>(static_cast<uint16_t*>(dst), src, size, params);
+        break;
+    case NormalizeOutput::float32:
+        normalize_u8_dispatch<NormalizeOutput::float32>(static_cast<float*>(dst), src, size, params);
+        break;
+    }
+}
+
+
+
+//
+// Dequantization
+//
+
+namespace {
+
+// Number of items processed at each iteration by the dequantization kernels
+constexpr size_t dq_block_size = 8;
+
+
+template<typename T>
+void dequantize_int_scalar(float* dst, const T* src, size_t first, size_t size, int32_t zero_point, float scale)
+{
+    for (size_t i = first; i < size; i++) {
+        dst[i] = (src[i] - zero_point) * scale;
+    }
+}
+
+
+void dequantize_f16_scalar(float* dst, const uint16_t* src, size_t first, size_t size)
+{
+    for (size_t i = first; i < size; i++) {
+        dst[i] = fp16_to_float(src[i]);
+    }
+}
+
+
+#if SYNAP_SIMD_X86
+
+// Same conversion as fp16_to_float(), input in the low 16 bits of each 32-bits lane
+__attribute__((target("sse4.1")))
+inline __m128 fp16_to_float_sse41(__m128i h)
+{
+    __m128i u = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+    __m128 f = _mm_mul_ps(_mm_castsi128_ps(u), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+    __m128 infnan = _mm_cmpge_ps(f, _mm_castsi128_ps(_mm_set1_epi32((127 + 16) << 23)));
+    f = _mm_or_ps(f, _mm_and_ps(infnan, _mm_castsi128_ps(_mm_set1_epi32(255 << 23))));
+    __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+    return _mm_or_ps(f, _mm_castsi128_ps(sign));
+}
+
+
+__attribute__((target("sse4.1")))
+void dequantize_i16_sse41(float* dst, const int16_t* src, size_t size, int32_t zero_point, float scale)
+{
+    const __m128i zp = _mm_set1_epi32(zero_point);
+    const __m128 sc = _mm_set1_ps(scale);
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i v0 = _mm_sub_epi32(_mm_cvtepi16_epi32(v), zp);
+        __m128i v1 = _mm_sub_epi32(_mm_cvtepi16_epi32(_mm_srli_si128(v, 8)), zp);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v0), sc));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(v1), sc));
+    }
+}
+
+
+__attribute__((target("sse4.1")))
+void dequantize_i32_sse41(float* dst, const int32_t* src, size_t size, int32_t zero_point, float scale)
+{
+    const __m128i zp = _mm_set1_epi32(zero_point);
+    const __m128 sc = _mm_set1_ps(scale);
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(v0, zp)), sc));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(v1, zp)), sc));
+    }
+}
+
+
+__attribute__((target("sse4.1")))
+void dequantize_f16_sse41(float* dst, const uint16_t* src, size_t size)
+{
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i, fp16_to_float_sse41(_mm_cvtepu16_epi32(v)));
+        _mm_storeu_ps(dst + i + 4, fp16_to_float_sse41(_mm_cvtepu16_epi32(_mm_srli_si128(v, 8))));
+    }
+}
+
+
+__attribute__((target("avx2")))
+void dequantize_i16_avx2(float* dst, const int16_t* src, size_t size, int32_t zero_point, float scale)
+{
+    const __m256i zp = _mm256_set1_epi32(zero_point);
+    const __m256 sc = _mm256_set1_ps(scale);
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m256i v32 = _mm256_sub_epi32(_mm256_cvtepi16_epi32(v), zp);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v32), sc));
+    }
+}
+
+
+__attribute__((target("avx2")))
+void dequantize_i32_avx2(float* dst, const int32_t* src, size_t size, int32_t zero_point, float scale)
+{
+    const __m256i zp = _mm256_set1_epi32(zero_point);
+    const __m256 sc = _mm256_set1_ps(scale);
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(v, zp)), sc));
+    }
+}
+
+
+__attribute__((target("avx2")))
+void dequantize_f16_avx2(float* dst, const uint16_t* src, size_t size)
+{
+    const __m256 magic = _mm256_castsi256_ps(_mm256_set1_epi32((254 - 15) << 23));
+    const __m256 infnan = _mm256_castsi256_ps(_mm256_set1_epi32((127 + 16) << 23));
+    const __m256 exp_mask = _mm256_castsi256_ps(_mm256_set1_epi32(255 << 23));
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        __m256i u = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x7fff)), 13);
+        __m256 f = _mm256_mul_ps(_mm256_castsi256_ps(u), magic);
+        f = _mm256_or_ps(f, _mm256_and_ps(_mm256_cmp_ps(f, infnan, _CMP_GE_OQ), exp_mask));
+        __m256i sign = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x8000)), 16);
+        _mm256_storeu_ps(dst + i, _mm256_or_ps(f, _mm256_castsi256_ps(sign)));
+    }
+}
+
+#endif  // SYNAP_SIMD_X86
+
+
+#if SYNAP_SIMD_NEON
+
+void dequantize_i16_neon(float* dst, const int16_t* src, size_t size, int32_t zero_point, float scale)
+{
+    const int32x4_t zp = vdupq_n_s32(zero_point);
+    const float32x4_t sc = vdupq_n_f32(scale);
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        int16x8_t v = vld1q_s16(src + i);
+        int32x4_t v0 = vsubq_s32(vmovl_s16(vget_low_s16(v)), zp);
+        int32x4_t v1 = vsubq_s32(vmovl_s16(vget_high_s16(v)), zp);
+        vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(v0), sc));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(v1), sc));
+    }
+}
+
+
+void dequantize_i32_neon(float* dst, const int32_t* src, size_t size, int32_t zero_point, float scale)
+{
+    const int32x4_t zp = vdupq_n_s32(zero_point);
+    const float32x4_t sc = vdupq_n_f32(scale);
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        int32x4_t v0 = vsubq_s32(vld1q_s32(src + i), zp);
+        int32x4_t v1 = vsubq_s32(vld1q_s32(src + i + 4), zp);
+        vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(v0), sc));
+        vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(v1), sc));
+    }
+}
+
+
+// Same conversion as fp16_to_float()
+inline float32x4_t fp16_to_float_neon(uint32x4_t h)
+{
+    uint32x4_t u = vshlq_n_u32(vandq_u32(h, vdupq_n_u32(0x7fff)), 13);
+    float32x4_t f = vmulq_f32(vreinterpretq_f32_u32(u), vreinterpretq_f32_u32(vdupq_n_u32((254 - 15) << 23)));
+    uint32x4_t infnan = vcgeq_f32(f, vreinterpretq_f32_u32(vdupq_n_u32((127 + 16) << 23)));
+    u = vorrq_u32(vreinterpretq_u32_f32(f), vandq_u32(infnan, vdupq_n_u32(255u << 23)));
+    u = vorrq_u32(u, vshlq_n_u32(vandq_u32(h, vdupq_n_u32(0x8000)), 16));
+    return vreinterpretq_f32_u32(u);
+}
+
+
+void dequantize_f16_neon(float* dst, const uint16_t* src, size_t size)
+{
+    for (size_t i = 0; i < size; i += dq_block_size) {
+        uint16x8_t v = vld1q_u16(src + i);
+        vst1q_f32(dst + i, fp16_to_float_neon(vmovl_u16(vget_low_u16(v))));
+        vst1q_f32(dst + i + 4, fp16_to_float_neon(vmovl_u16(vget_high_u16(v))));
+    }
+}
+
+#endif  // SYNAP_SIMD_NEON
+
+
+// Number of items that can be processed by the SIMD kernels
+inline size_t dq_simd_size(size_t size)
+{
+    return simd_level() == SimdLevel::none ? 0 : size - size % dq_block_size;
+}
+
+}  // namespace
+
+
+void dequantize_i16(float* dst, const int16_t* src, size_t size, int32_t zero_point, float scale)
+{
+    const size_t simd_size = dq_simd_size(size);
+    switch (simd_level()) {
+#if SYNAP_SIMD_X86
+    case SimdLevel::avx2:
+        dequantize_i16_avx2(dst, src, simd_size, zero_point, scale);
+        break;
+    case SimdLevel::sse41:
+        dequantize_i16_sse41(dst, src, simd_size, zero_point, scale);
+        break;
+#endif
+#if SYNAP_SIMD_NEON
+    case SimdLevel::neon:
+        dequantize_i16_neon(dst, src, simd_size, zero_point, scale);
+        break;
+#endif
+    default:
+        break;
+    }
+    dequantize_int_scalar(dst, src, simd_size, size, zero_point, scale);
+}
+
+
+void dequantize_i32(float* dst, const int32_t* src, size_t size, int32_t zero_point, float scale)
+{
+    const size_t simd_size = dq_simd_size(size);
+    switch (simd_level()) {
+#if SYNAP_SIMD_X86
+    case SimdLevel::avx2:
+        dequantize_i32_avx2(dst, src, simd_size, zero_point, scale);
+        break;
+    case SimdLevel::sse41:
+        dequantize_i32_sse41(dst, src, simd_size, zero_point, scale);
+        break;
+#endif
+#if SYNAP_SIMD_NEON
+    case SimdLevel::neon:
+        dequantize_i32_neon(dst, src, simd_size, zero_point, scale);
+        break;
+#endif
+    default:
+        break;
+    }
+    dequantize_int_scalar(dst, src, simd_size, size, zero_point, scale);
+}
+
+
+void dequantize_f16(float* dst, const uint16_t* src, size_t size)
+{
+    const size_t simd_size = dq_simd_size(size);
+    switch (simd_level()) {
+#if SYNAP_SIMD_X86
+    case SimdLevel::avx2:
+        dequantize_f16_avx2(dst, src, simd_size);
+        break;
+    case SimdLevel::sse41:
+        dequantize_f16_sse41(dst, src, simd_size);
+        break;
+#endif
+#if SYNAP_SIMD_NEON
+    case SimdLevel::neon:
+        dequantize_f16_neon(dst, src, simd_size);
+        break;
+#endif
+    default:
+        break;
+    }
+    dequantize_f16_scalar(dst, src, simd_size, size);
+}
+
+
+}  // namespace synap
+}  // namespace synaptics
@@ -0,0 +1,120 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+///
+/// Vectorized data [de]quantization and normalization kernels.
+///
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace synaptics {
+namespace synap {
+
+
+// Convert fp16 value to float
+inline float fp16_to_float(uint16_t in)
+{
+    constexpr uint32_t magic = (254 - 15) << 23;
+    constexpr uint32_t infnan = (127 + 16) << 23;
+    float magic_f, infnan_f, out;
+    memcpy(&magic_f, &magic, sizeof(magic_f));
+    memcpy(&infnan_f, &infnan, sizeof(infnan_f));
+    // Non-sign bits
+    uint32_t u = (in & 0x7fffu) << 13;
+    memcpy(&out, &u, sizeof(out));
+    out *= magic_f;
+    memcpy(&u, &out, sizeof(u));
+    if (out >= infnan_f) {
+        u |= 255u << 23;
+    }
+    // Sign bit
+    u |= (in & 0x8000u) << 16;
+    memcpy(&out, &u, sizeof(out));
+    return out;
+}
+
+
+// Convert 32bit float value to fp16 (truncating the mantissa, no infinity)
+inline uint16_t float_to_fp16(float in)
+{
+    uint32_t fp32;
+    memcpy(&fp32, &in, sizeof(fp32));
+    uint32_t sign = (fp32 & 0x80000000u) >> 16;
+    uint32_t exponent = (fp32 & 0x7F800000u) >> 13;
+    uint32_t mantissa = (fp32 & 0x007FE000u) >> 13;  // No rounding
+    uint32_t fp16 = 0u;
+    if (exponent >= 0x023c00u) {
+        fp16 = sign | 0x7BFF;  // Don't round to infinity
+    }
+    else if (exponent <= 0x01c000u) {
+        fp16 = sign;
+    }
+    else {
+        exponent -= 0x01c000u;
+        fp16 = sign | exponent | mantissa;
+    }
+    return fp16;
+}
+
+
+/// Data type generated by the normalization kernel
+enum class NormalizeOutput { uint8, int8, int16, float16, float32 };
+
+
+/// Normalization of uint8 data.
+/// Each value is computed as (src[i] - mean[i % mean_count]) * mul / div (+ add for integer outputs)
+/// and then converted to the output type. Integer outputs are saturated and either rounded
+/// (as in to_int()) or truncated. The computation is done with the same float operations as
+/// the scalar code so the results are identical.
+struct NormalizeU8Params {
+    NormalizeOutput output;
+
+    // Mean pattern, repeated along the data
+    const float* mean;
+    size_t mean_count;
+
+    float mul;
+    float div;
+    float add;
+
+    // Round to nearest (else truncate), integer outputs only
+    bool round;
+};
+
+
+/// Normalize and convert uint8 data using the best SIMD instruction set available.
+///
+/// @param dst: destination data
+/// @param src: uint8 source data
+/// @param size: number of items to convert
+/// @param params: normalization parameters (mean_count up to 64)
+void normalize_u8(void* dst, const uint8_t* src, size_t size, const NormalizeU8Params& params);
+
+
+/// Dequantize int16 data using the best SIMD instruction set available.
+/// Each value is computed as (src[i] - zero_point) * scale.
+///
+/// @param dst: destination data
+/// @param src: int16 source data
+/// @param size: number of items to convert
+/// @param zero_point: zero point
+/// @param scale: scale factor
+void dequantize_i16(float* dst, const int16_t* src, size_t size, int32_t zero_point, float scale);
+
+
+/// Dequantize int32 data using the best SIMD instruction set available.
+/// Each value is computed as (src[i] - zero_point) * scale.
+void dequantize_i32(float* dst, const int32_t* src, size_t size, int32_t zero_point, float scale);
+
+
+/// Convert fp16 data to float using the best SIMD instruction set available.
+void dequantize_f16(float* dst, const uint16_t* src, size_t size);
+
+
+}  // namespace synap
+}  // namespace synaptics
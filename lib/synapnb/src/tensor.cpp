@@ -14,6 +14,7 @@
 #include "synap/tensor.hpp"
 #include "synap/timer.hpp"
 
+#include <atomic>
 #include <cmath>
 
 
@@ -55,6 +56,15 @@ struct Tensor::Private
     // Contains dequantized data if dequantization not done by the network itself
     std::vector<float> _dequantized_data;
 
+    // Dequantization kernel selected according to the tensor attributes
+    unique_ptr<const Dequantizer> _dequantizer{};
+
+    // Incremented each time the tensor content may have changed
+    atomic<uint64_t> _generation{1};
+
+    // Value of _generation when _dequantized_data was computed
+    uint64_t _dequantized_generation{};
+
     // Scaling factor to apply when assigning scalar tensors
     double _scalar_scale{};
 
@@ -73,6 +83,7 @@ Tensor::Tensor(NetworkPrivate* np, int32_t ix, Type ttype, const TensorAttribute
     d->_index = ix;
     d->_type = ttype;
     d->_attr.reset(new TensorAttributes(*attr));
+    d->_dequantizer.reset(new Dequantizer(d->_attr.get()));
     d->_owner = this;
     if (is_scalar()) {
         // Extract scaling factor for cropping tensors
@@ -130,7 +141,7 @@ Layout Tensor::layout() const
 }
 
 
-string Tensor::format() const
+const string& Tensor::format() const
 {
     return d->_attr->format;
 }
@@ -170,6 +181,7 @@ bool Tensor::set_buffer(Buffer* buffer)
     if (!buffer) {
         LOGI << "Unset buffer for: " << name();
         d->_buffer = d->_set_buffer = nullptr;
+        invalidate();
         return true;
     }
     if (buffer == d->_set_buffer) {
@@ -212,6 +224,7 @@ bool Tensor::set_buffer(Buffer* buffer)
 
     LOGI << "Buffer set for tensor: " << name();
     d->_set_buffer = d->_buffer = buffer;
+    invalidate();
 
     return success;
 }
@@ -219,12 +232,16 @@ bool Tensor::set_buffer(Buffer* buffer)
 
 Buffer* Tensor::buffer()
 {
+    // Buffer content can be modified by the caller
+    invalidate();
     return d->_buffer;
 }
 
 
 void* Tensor::data()
 {
+    // Data can be modified by the caller
+    invalidate();
     if (d->_buffer == &d->_default_buffer && d->_buffer->size() == 0) {
         // Automatically allocate memory for default buffer
         d->_buffer->resize(size());
@@ -269,6 +286,7 @@ bool Tensor::assign(const void* data, size_t sz)
         LOGE << "Bad data size. Expected: " << size() << ", got: " << sz;
         return false;
     }
+    invalidate();
     return d->_buffer->assign(data, sz);
 }
 
@@ -292,6 +310,21 @@ bool Tensor::assign(const uint8_t* in_data, size_t count)
 }
 
 
+bool Tensor::assign(const uint8_t* in_data, size_t offset, size_t count)
+{
+    if (!buffer()) {
+        LOGE << "Tensor has no associated buffer";
+        return false;
+    }
+    if (offset > item_count() || count > item_count() - offset) {
+        LOGE << "Bad data range. Tensor items: " << item_count() << ", got: " << offset << "+" << count;
+        return false;
+    }
+    uint8_t* dst = static_cast<uint8_t*>(data()) + offset * synap_type_size(data_type());
+    return normalize_quantize(dst, in_data, count, d->_attr.get(), offset);
+}
+
+
 bool Tensor::assign(const int16_t* in_data, size_t count)
 {
     return assignable(this, count) && normalize_quantize(data(), in_data, count, d->_attr.get());
@@ -377,15 +410,65 @@ const float* Tensor::as_float() const
         return static_cast<const float*>(raw_data);
     }
 
-    // Dequantize data
-    auto raw_data_bytes = static_cast<const uint8_t*>(raw_data);
-    size_t n = item_count();
-    d->_dequantized_data.resize(n);
-    dequantize(d->_dequantized_data.data(), raw_data_bytes, n, d->_attr.get());
+    // Dequantize data unless already done for the current content
+    const uint64_t generation = d->_generation;
+    if (d->_dequantized_generation != generation) {
+        auto raw_data_bytes = static_cast<const uint8_t*>(raw_data);
+        size_t n = item_count();
+        d->_dequantized_data.resize(n);
+        d->_dequantizer->dequantize(d->_dequantized_data.data(), raw_data_bytes, n);
+        d->_dequantized_generation = generation;
+    }
     return d->_dequantized_data.data();
 }
 
 
+bool Tensor::as_float(float* dst, size_t offset, size_t count, size_t stride) const
+{
+    const void* raw_data = data();
+    if (!raw_data) {
+        LOGE << "Tensor contains no data";
+        return false;
+    }
+    const size_t n = item_count();
+    if (count && (!stride || offset >= n || (count - 1) > (n - 1 - offset) / stride)) {
+        LOGE << "Range " << offset << "+" << count << "*" << stride << " out of bounds for tensor "
+             << name() << " with " << n << " items";
+        return false;
+    }
+
+    const float* float_data = data_type() == DataType::float32 ? static_cast<const float*>(raw_data) :
+                              d->_dequantized_generation == d->_generation ? d->_dequantized_data.data() :
+                              nullptr;
+    if (float_data) {
+        // Tensor already in float or whole tensor already dequantized
+        if (stride == 1) {
+            memcpy(dst, float_data + offset, count * sizeof(float));
+        }
+        else {
+            for (size_t i = 0; i < count; i++) {
+                dst[i] = float_data[offset + i * stride];
+            }
+        }
+        return true;
+    }
+    auto raw_data_bytes = static_cast<const uint8_t*>(raw_data) + offset * synap_type_size(data_type());
+    return d->_dequantizer->dequantize(dst, raw_data_bytes, count, stride);
+}
+
+
+bool Tensor::quantized_threshold(float threshold, int32_t* quantized) const
+{
+    return d->_dequantizer->quantized_threshold(threshold, quantized);
+}
+
+
+void Tensor::invalidate()
+{
+    ++d->_generation;
+}
+
+
 void Tensor::add_sibling(Tensor* t)
 {
     d->_siblings.push_back(t);
@@ -0,0 +1,163 @@
+// Copyright 2025 Synaptics Incorporated
+// SPDX-License-Identifier: Apache-2.0
+
+#include "synap/trace.hpp"
+#include "synap/file_utils.hpp"
+#include "synap/logging.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+namespace synaptics {
+namespace synap {
+
+namespace {
+
+// Recorded event
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    int64_t begin;
+    int64_t end;
+    int64_t arg;
+    uint32_t tid;
+};
+
+
+// Ring buffer of recorded events
+struct TraceBuffer {
+    mutex mtx;
+    vector<TraceEvent> events;
+    size_t next{};
+    size_t count{};
+};
+
+
+TraceBuffer& trace_buffer()
+{
+    static TraceBuffer buffer;
+    return buffer;
+}
+
+
+// Small sequential thread ids are more readable than the system ones in the trace viewer
+uint32_t trace_thread_id()
+{
+    static atomic<uint32_t> thread_count{};
+    thread_local uint32_t tid = ++thread_count;
+    return tid;
+}
+
+
+// Enable tracing at startup and save the trace at exit if requested with environment variables
+struct TraceFromEnvironment {
+    string file_name;
+
+    TraceFromEnvironment()
+    {
+        const char* trace_file = getenv("SYNAP_NB_TRACE");
+        if (trace_file && *trace_file) {
+            file_name = trace_file;
+            const char* capacity = getenv("SYNAP_NB_TRACE_EVENTS");
+            Trace::enable(capacity ? strtoul(capacity, nullptr, 10) : Trace::default_capacity);
+        }
+    }
+
+    ~TraceFromEnvironment()
+    {
+        if (!file_name.empty() && !Trace::save(file_name)) {
+            LOGE << "Failed to save trace to: " << file_name;
+        }
+    }
+};
+
+TraceFromEnvironment trace_from_environment;
+
+}  // namespace
+
+
+std::atomic<bool> Trace::_enabled{};
+
+
+void Trace::enable(size_t capacity)
+{
+    TraceBuffer& buffer = trace_buffer();
+    lock_guard<mutex> lock(buffer.mtx);
+    buffer.events.assign(max<size_t>(capacity, 1), {});
+    buffer.next = 0;
+    buffer.count = 0;
+    _enabled = true;
+}
+
+
+void Trace::disable()
+{
+    _enabled = false;
+}
+
+
+int64_t Trace::now()
+{
+    auto t = chrono::steady_clock::now().time_since_epoch();
+    return chrono::duration_cast<chrono::microseconds>(t).count();
+}
+
+
+void Trace::record(const char* name, const char* category, int64_t begin, int64_t end, int64_t arg)
+{
+    uint32_t tid = trace_thread_id();
+    TraceBuffer& buffer = trace_buffer();
+    lock_guard<mutex> lock(buffer.mtx);
+    if (buffer.events.empty()) {
+        return;
+    }
+    buffer.events[buffer.next] = {name, category, begin, end, arg, tid};
+    buffer.next = (buffer.next + 1) % buffer.events.size();
+    buffer.count = min(buffer.count + 1, buffer.events.size());
+}
+
+
+std::string Trace::to_json()
+{
+    TraceBuffer& buffer = trace_buffer();
+    lock_guard<mutex> lock(buffer.mtx);
+    const int pid = getpid();
+    ostringstream json;
+    json << "{\"traceEvents\":[";
+    size_t first = (buffer.next + buffer.events.size() - buffer.count) % max<size_t>(buffer.events.size(), 1);
+    for (size_t i = 0; i < buffer.count; i++) {
+        const TraceEvent& e = buffer.events[(first + i) % buffer.events.size()];
+        json << (i ? ",\n" : "\n");
+        json << "{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+             << "\",\"ph\":\"X\",\"ts\":" << e.begin << ",\"dur\":" << e.end - e.begin
+             << ",\"pid\":" << pid << ",\"tid\":" << e.tid;
+        if (e.arg >= 0) {
+            json << ",\"args\":{\"index\":" << e.arg << "}";
+        }
+        json << "}";
+    }
+    json << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return json.str();
+}
+
+
+bool Trace::save(const std::string& file_name)
+{
+    string json = to_json();
+    if (!binary_file_write(file_name, json.data(), json.size())) {
+        return false;
+    }
+    LOGI << "Trace saved to: " << file_name;
+    return true;
+}
+
+
+}  // namespace synap
+}  // namespace synaptics